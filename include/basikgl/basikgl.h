@@ -20,6 +20,8 @@
 #include <basikgl/context/context_properties.h>
 #include <basikgl/context/render_context.h>
 #include <basikgl/context/context_manager.h>
+#include <basikgl/context/gl_state_cache.h>
+#include <basikgl/context/uniform_block_registry.h>
 
 /// @dir window
 #include <basikgl/window/window_attributes.h>
@@ -28,14 +30,37 @@
 #include <basikgl/window/window.h>
 
 /// @dir gfx
+#include <basikgl/gfx/vertex_layout.h>
 #include <basikgl/gfx/vertex.h>
+#include <basikgl/gfx/vertex_data.h>
+#include <basikgl/gfx/vertex_packing.h>
+#include <basikgl/gfx/mesh_optimizer.h>
+#include <basikgl/gfx/vertex_welder.h>
+#include <basikgl/gfx/bounds.h>
+#include <basikgl/gfx/dirty_ranges.h>
+#include <basikgl/gfx/buffer_storage.h>
+#include <basikgl/gfx/residency.h>
 #include <basikgl/gfx/vertexbuffer.h>
 #include <basikgl/gfx/indexbuffer.h>
+#include <basikgl/gfx/instancebuffer.h>
+#include <basikgl/gfx/streambuffer.h>
+#include <basikgl/gfx/indirectbuffer.h>
+#include <basikgl/gfx/uniformbuffer.h>
+#include <basikgl/gfx/lod.h>
 #include <basikgl/gfx/vertexarray.h>
+#include <basikgl/gfx/range_allocator.h>
+#include <basikgl/gfx/mesh_pool.h>
 #include <basikgl/gfx/shader.h>
+#include <basikgl/gfx/program_binary_cache.h>
 
 /// @dir render
+#include <basikgl/render/frustum.h>
+#include <basikgl/render/lod_selector.h>
+#include <basikgl/render/render_queue.h>
 #include <basikgl/render/renderer.h>
+#include <basikgl/render/batch_renderer.h>
+#include <basikgl/render/render_command.h>
+#include <basikgl/render/render_thread.h>
 
 /// @dir sprite
 #include <basikgl/sprite/sprite.h>
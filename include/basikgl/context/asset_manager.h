@@ -6,12 +6,18 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <span>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
 #include <basikgl/core/core.h>
 #include <basikgl/gfx/asset.h>
+#include <basikgl/gfx/vertex.h>
+#include <basikgl/gfx/vertex_data.h>
+#include <basikgl/gfx/buffer_storage.h>
 #include <basikgl/utils/uuid_generator.h>
 
 /**
@@ -23,12 +29,18 @@ namespace bskgl {
     /// @brief Forward declaration of RenderContext class.
     class RenderContext;
 
-    /// @brief Forward declaration of Vertex struct.
-    struct Vertex;
+    /// @brief Forward declaration of VertexBuffer class.
+    class VertexBuffer;
+
+    /// @brief Forward declaration of IndexBuffer class.
+    class IndexBuffer;
 
     /// @brief Forward declaration of VertexArray class.
     class VertexArray;
 
+    /// @brief Forward declaration of Shader class.
+    class Shader;
+
     /**
      * @class AssetManager
      * @brief Creates, manages and destroys assets.
@@ -44,6 +56,41 @@ namespace bskgl {
         using AssetHandle = std::shared_ptr<T>;
 
     private:
+        /**
+         * @struct Allocator
+         * @brief Allocator used to place an asset and its reference count in one allocation.
+         * Nested so it shares the friendship assets grant to the asset manager and can reach their private constructors.
+         * 
+         * @tparam T Type allocated.
+         */
+        template <typename T>
+        struct Allocator {
+            using value_type = T;
+
+            Allocator() noexcept = default;
+
+            template <typename U>
+            Allocator(const Allocator<U>&) noexcept { }
+
+            T* allocate(size_t count) {
+                return std::allocator<T>().allocate(count);
+            }
+
+            void deallocate(T* ptr, size_t count) noexcept {
+                std::allocator<T>().deallocate(ptr, count);
+            }
+
+            template <typename U, typename... Args>
+            void construct(U* ptr, Args&& ...args) {
+                ::new (static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+            }
+
+            template <typename U>
+            bool operator==(const Allocator<U>&) const noexcept {
+                return true;
+            }
+        };
+
         /**
          * @brief Constructor
          * 
@@ -68,6 +115,8 @@ namespace bskgl {
 
         /**
          * @brief Creates an asset, see @class Asset in @headerfile gfx/asset.
+         * The asset is constructed on the thread owning the OpenGL context, the call waits for it.
+         * Arguments are forwarded, pass vectors as rvalues to move them into the asset instead of copying.
          * 
          * @tparam Ast Asset type, @example Shader, VertexArray etc.
          * @tparam ...Args Arguments to be passed to constructor of the asset.
@@ -78,14 +127,31 @@ namespace bskgl {
          * @returns UUID of the newly created asset.
          */
         template <typename Ast, typename... Args>
-        UUID create_asset(const Args& ...args) {
-            m_bind_ctx();
-    
-            UUID uuid = utils::UUIDGenerator::generate();
-    
-            m_assets[uuid] = AssetHandle<Asset>(new Ast(uuid, args...));
-    
-            return uuid;
+        UUID create_asset(Args&& ...args) {
+            if constexpr (std::is_same_v<Ast, VertexArray>)
+                return m_create_vertex_array(std::forward<Args>(args)...);
+            else
+                return m_emplace<Ast>(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Creates an asset whose OpenGL work finishes in the background, currently only shaders.
+         * Compilation and linking are submitted without waiting for the driver, so creating many shaders in a row overlaps their compilation.
+         * The shader can't be bound until @fn Shader::ready(), the renderers skip its draws until then.
+         * 
+         * @tparam Ast Asset type, @example Shader.
+         * @tparam ...Args Arguments to be passed to constructor of the asset.
+         * 
+         * @param[in] args Arguments to be passed to constructor of the asset.
+         * 
+         * @retval UUID
+         * @returns UUID of the newly created asset.
+         */
+        template <typename Ast, typename... Args>
+        UUID create_asset_async(Args&& ...args) {
+            static_assert(std::is_same_v<Ast, Shader>, "Only shaders can be created asynchronously.");
+
+            return m_emplace<Ast>(std::forward<Args>(args)..., true);
         }
 
         /**
@@ -110,6 +176,7 @@ namespace bskgl {
 
         /**
          * @brief Deletes the given asset.
+         * If the context is threaded, the asset is released on the render thread after the draws recorded before.
          * 
          * @param[in] uuid UUID of the asset to delete.
          */
@@ -117,9 +184,112 @@ namespace bskgl {
 
     private:
         /**
-         * @brief Binds the parent context to make sure assets are correct context wise.
+         * @brief Constructs an asset and its reference count in one allocation and stores it.
+         * 
+         * @tparam Ast Asset type.
+         * @tparam ...Args Arguments to be passed to constructor of the asset.
+         * 
+         * @param[in] args Arguments to be passed to constructor of the asset.
+         * 
+         * @retval UUID
+         * @returns UUID of the newly created asset.
          */
-        void m_bind_ctx();
+        template <typename Ast, typename... Args>
+        UUID m_emplace(Args&& ...args) {
+            UUID uuid = utils::UUIDGenerator::generate();
+            AssetHandle<Asset> asset;
+
+            m_execute([&]() { asset = std::allocate_shared<Ast>(Allocator<Ast>(), uuid, std::forward<Args>(args)...); });
+    
+            m_assets[uuid] = std::move(asset);
+    
+            return uuid;
+        }
+
+        /**
+         * @brief Creates a vertex array along with its vertex and index buffers, the data is moved into the buffers.
+         * 
+         * @param[in] vertices Vertices and their layout.
+         * @param[in] indices Vector of uint32_t indices, empty for non indexed draws.
+         * @param[in] usage Usage class of the vertex and index buffers.
+         * 
+         * @retval UUID
+         * @returns UUID of the created vertex array.
+         */
+        UUID m_create_vertex_array(VertexData vertices, std::vector<uint32_t> indices = {}, BufferUsage usage = BufferUsage::Dynamic);
+
+        /**
+         * @brief Creates a vertex array along with its vertex and index buffers, the vectors are moved into the buffers.
+         * 
+         * @tparam V Vertex type, its format becomes the layout of the vertex array.
+         * 
+         * @param[in] vertices Vector of vertices.
+         * @param[in] indices Vector of uint32_t indices, empty for non indexed draws.
+         * @param[in] usage Usage class of the vertex and index buffers.
+         * 
+         * @retval UUID
+         * @returns UUID of the created vertex array.
+         */
+        template <VertexType V>
+        UUID m_create_vertex_array(std::vector<V> vertices, std::vector<uint32_t> indices = {}, BufferUsage usage = BufferUsage::Dynamic) {
+            return m_create_vertex_array(VertexData(std::move(vertices)), std::move(indices), usage);
+        }
+
+        /**
+         * @brief Creates a vertex array along with a vertex buffer, without indices.
+         * 
+         * @tparam V Vertex type, its format becomes the layout of the vertex array.
+         * 
+         * @param[in] vertices Vector of vertices.
+         * @param[in] usage Usage class of the vertex and index buffers.
+         * 
+         * @retval UUID
+         * @returns UUID of the created vertex array.
+         */
+        template <VertexType V>
+        UUID m_create_vertex_array(std::vector<V> vertices, BufferUsage usage) {
+            return m_create_vertex_array(VertexData(std::move(vertices)), std::vector<uint32_t>(), usage);
+        }
+
+        /**
+         * @brief Creates a vertex array, copying the vertices and indices once into the buffers.
+         * 
+         * @tparam V Vertex type, its format becomes the layout of the vertex array.
+         * @tparam Extent Extent of the vertex span.
+         * 
+         * @param[in] vertices Span of vertices.
+         * @param[in] indices Span of uint32_t indices, empty for non indexed draws.
+         * @param[in] usage Usage class of the vertex and index buffers.
+         * 
+         * @retval UUID
+         * @returns UUID of the created vertex array.
+         */
+        template <typename V, size_t Extent>
+            requires VertexType<std::remove_const_t<V>>
+        UUID m_create_vertex_array(std::span<V, Extent> vertices, std::span<const uint32_t> indices = {}, BufferUsage usage = BufferUsage::Dynamic) {
+            return m_create_vertex_array(
+                VertexData(std::vector<std::remove_const_t<V>>(vertices.begin(), vertices.end())),
+                std::vector<uint32_t>(indices.begin(), indices.end()),
+                usage);
+        }
+
+        /**
+         * @brief Creates a vertex array from existing buffers.
+         * 
+         * @param[in] vbuffer Shared ptr of the vertex buffer.
+         * @param[in] ibuffer Shared ptr of the index buffer.
+         * 
+         * @retval UUID
+         * @returns UUID of the created vertex array.
+         */
+        UUID m_create_vertex_array(AssetHandle<VertexBuffer> vbuffer, AssetHandle<IndexBuffer> ibuffer);
+
+        /**
+         * @brief Runs a task on the thread owning the parent context and waits for it, used for constructing assets.
+         * 
+         * @param[in] task Task to run.
+         */
+        void m_execute(const std::function<void()>& task);
 
     private:
         /**
@@ -133,27 +303,4 @@ namespace bskgl {
         std::unordered_map<UUID, AssetHandle<Asset>> m_assets;
     };
 
-    /**
-     * @brief Template specialization for @class VertexArray.
-     * 
-     * @param[in] vertices Vector of @struct Vertex.
-     * 
-     * @retval UUID
-     * @returns UUID of the created vertex array.
-     */
-    template <>
-    UUID AssetManager::create_asset<VertexArray>(const std::vector<Vertex>& vertices);
-    
-    /**
-     * @brief Template specialization for @class VertexArray.
-     * 
-     * @param[in] vertices Vector of @struct Vertex vertices.
-     * @param[in] indices Vector of uint32_t indices.
-     * 
-     * @retval UUID
-     * @returns UUID of the created vertex array.
-     */
-    template <>
-    UUID AssetManager::create_asset<VertexArray>(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
-
 }
\ No newline at end of file
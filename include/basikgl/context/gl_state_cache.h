@@ -0,0 +1,326 @@
+/**
+ * @file context/gl_state_cache.h
+ * @brief Contains the per-context OpenGL state cache used to elide redundant state changes.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <array>
+
+#include <glm/glm.hpp>
+
+#include <basikgl/core/core.h>
+#include <basikgl/context/gl_tests.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /// @brief Forward declaration for RenderContext class.
+    class RenderContext;
+
+    /**
+     * @class GLStateCache
+     * @brief Shadows the OpenGL state of a context and skips calls that would not change it.
+     * Every bind in the library goes through the cache of the context current on the calling thread.
+     * If OpenGL state is changed outside of the library, call @fn GLStateCache::invalidate().
+     */
+    class BSK_API GLStateCache final {
+        friend RenderContext;
+    public:
+        /**
+         * @struct Statistics
+         * @brief Number of state changes issued to and elided from OpenGL.
+         */
+        struct Statistics {
+            /**
+             * @property Number of calls issued to OpenGL.
+             */
+            size_t issued = 0;
+
+            /**
+             * @property Number of calls skipped because they would not change anything.
+             */
+            size_t elided = 0;
+        };
+
+        /**
+         * @property Number of texture units shadowed, binds to higher units are always issued.
+         */
+        static constexpr uint32_t max_texture_units = 32;
+
+    private:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] passthrough If true, no state is shadowed and every call is issued.
+         */
+        explicit GLStateCache(bool passthrough = false);
+
+    public:
+        /**
+         * @brief Move Constructor
+         */
+        GLStateCache(GLStateCache&& other) noexcept = default;
+
+        /**
+         * @brief Destructor
+         */
+        ~GLStateCache() = default;
+
+        GLStateCache(const GLStateCache& other) = delete;
+        GLStateCache& operator=(const GLStateCache& other) = delete;
+        GLStateCache& operator=(GLStateCache&& other) noexcept = delete;
+
+        /**
+         * @brief Returns the state cache of the context bound on this thread.
+         * If no context has been bound through @fn RenderContext::bind(), returns a cache which issues every call.
+         *
+         * @retval GLStateCache&
+         * @returns State cache of the current context.
+         */
+        static GLStateCache& active();
+
+        /**
+         * @brief Checks if a context is bound on this thread.
+         * False on the application thread once the render thread owns the context.
+         *
+         * @retval bool
+         * @returns True if OpenGL can be called on this thread.
+         */
+        [[nodiscard]]
+        static bool has_current();
+
+        /**
+         * @brief Binds a shader program (glUseProgram).
+         *
+         * @param[in] program OpenGL ID of the program.
+         */
+        void use_program(uint32_t program);
+
+        /**
+         * @brief Binds a vertex array (glBindVertexArray).
+         *
+         * @param[in] vertexarray OpenGL ID of the vertex array.
+         */
+        void bind_vertex_array(uint32_t vertexarray);
+
+        /**
+         * @brief Binds a buffer (glBindBuffer).
+         * Element array buffer binding is part of the vertex array state, its shadow is reset when the vertex array changes.
+         *
+         * @param[in] target OpenGL buffer target, @example GL_ARRAY_BUFFER.
+         * @param[in] buffer OpenGL ID of the buffer.
+         */
+        void bind_buffer(uint32_t target, uint32_t buffer);
+
+        /**
+         * @brief Binds a range of a buffer to an indexed binding point (glBindBufferRange).
+         * Indexed bindings aren't shadowed, but the call also binds the generic target so its shadow is updated.
+         *
+         * @param[in] target OpenGL indexed buffer target, @example GL_SHADER_STORAGE_BUFFER.
+         * @param[in] index Binding point.
+         * @param[in] buffer OpenGL ID of the buffer.
+         * @param[in] offset Offset of the range in bytes, a multiple of the target's offset alignment.
+         * @param[in] size Size of the range in bytes.
+         */
+        void bind_buffer_range(uint32_t target, uint32_t index, uint32_t buffer, size_t offset, size_t size);
+
+        /**
+         * @brief Binds a texture to a texture unit (glBindTextureUnit).
+         *
+         * @param[in] unit Texture unit.
+         * @param[in] texture OpenGL ID of the texture.
+         */
+        void bind_texture_unit(uint32_t unit, uint32_t texture);
+
+        /**
+         * @brief Binds a texture to the active texture unit (glBindTexture), needed before a texture has a target.
+         * The library never changes the active texture unit, so this shadows texture unit 0.
+         *
+         * @param[in] target OpenGL texture target, @example GL_TEXTURE_2D.
+         * @param[in] texture OpenGL ID of the texture.
+         */
+        void bind_texture(uint32_t target, uint32_t texture);
+
+        /**
+         * @brief Enables an OpenGL test (glEnable).
+         *
+         * @param[in] test Test to enable.
+         */
+        void enable(GLTest test);
+
+        /**
+         * @brief Disables an OpenGL test (glDisable).
+         *
+         * @param[in] test Test to disable.
+         */
+        void disable(GLTest test);
+
+        /**
+         * @brief Sets the clear color (glClearColor).
+         *
+         * @param[in] color Normalized clear color.
+         */
+        void set_clear_color(const glm::vec4& color);
+
+        /**
+         * @brief Returns the clear color, only queries OpenGL if the clear color is unknown.
+         *
+         * @retval glm::vec4
+         * @returns Normalized clear color.
+         */
+        [[nodiscard]]
+        glm::vec4 clear_color();
+
+        /**
+         * @brief Forgets shadowed bindings of a deleted buffer, OpenGL may reuse its ID.
+         *
+         * @param[in] buffer OpenGL ID of the deleted buffer.
+         */
+        void on_buffer_deleted(uint32_t buffer);
+
+        /**
+         * @brief Forgets shadowed bindings of a deleted vertex array, OpenGL may reuse its ID.
+         *
+         * @param[in] vertexarray OpenGL ID of the deleted vertex array.
+         */
+        void on_vertex_array_deleted(uint32_t vertexarray);
+
+        /**
+         * @brief Forgets the shadowed element array buffer binding if a vertex array had its element buffer attached without binding it.
+         *
+         * @param[in] vertexarray OpenGL ID of the modified vertex array.
+         */
+        void on_vertex_array_modified(uint32_t vertexarray);
+
+        /**
+         * @brief Forgets shadowed bindings of a deleted program, OpenGL may reuse its ID.
+         *
+         * @param[in] program OpenGL ID of the deleted program.
+         */
+        void on_program_deleted(uint32_t program);
+
+        /**
+         * @brief Forgets shadowed bindings of a deleted texture, OpenGL may reuse its ID.
+         *
+         * @param[in] texture OpenGL ID of the deleted texture.
+         */
+        void on_texture_deleted(uint32_t texture);
+
+        /**
+         * @brief Marks all the shadowed state as unknown, the next call of each kind is always issued.
+         */
+        void invalidate();
+
+        /**
+         * @retval const Statistics&
+         * @returns Number of issued and elided calls.
+         */
+        [[nodiscard]]
+        const Statistics& statistics() const;
+
+        /**
+         * @brief Resets the issued and elided call counters.
+         */
+        void reset_statistics();
+
+    private:
+        /**
+         * @brief Returns the shadow slot for a buffer target.
+         *
+         * @param[in] target OpenGL buffer target.
+         *
+         * @retval uint32_t*
+         * @returns Pointer to the shadowed binding, nullptr if the target isn't shadowed.
+         */
+        uint32_t* m_buffer_slot(uint32_t target);
+
+        /**
+         * @brief Updates a shadowed value, counting the call as issued or elided.
+         *
+         * @param[inout] slot Shadowed value.
+         * @param[in] value New value.
+         *
+         * @retval bool
+         * @returns True if the call has to be issued.
+         */
+        bool m_update(uint32_t& slot, uint32_t value);
+
+    private:
+        /**
+         * @property Value of a shadowed binding whose state is unknown.
+         */
+        static constexpr uint32_t s_unknown = UINT32_MAX;
+
+        /**
+         * @property State cache of the context bound on this thread.
+         */
+        static thread_local GLStateCache* s_current;
+
+    private:
+        /**
+         * @property If true, every call is issued.
+         */
+        bool m_passthrough;
+
+        /**
+         * @property Bound shader program.
+         */
+        uint32_t m_program;
+
+        /**
+         * @property Bound vertex array.
+         */
+        uint32_t m_vertexarray;
+
+        /**
+         * @property Bound array buffer.
+         */
+        uint32_t m_array_buffer;
+
+        /**
+         * @property Bound element array buffer (part of the bound vertex array).
+         */
+        uint32_t m_element_buffer;
+
+        /**
+         * @property Bound buffers of other shadowed targets (uniform, shader storage, draw indirect).
+         */
+        std::array<uint32_t, 3> m_other_buffers;
+
+        /**
+         * @property Bound textures per texture unit.
+         */
+        std::array<uint32_t, max_texture_units> m_textures;
+
+        /**
+         * @property Tests whose state is known.
+         */
+        int32_t m_known_tests;
+
+        /**
+         * @property Enabled tests among the known tests.
+         */
+        int32_t m_enabled_tests;
+
+        /**
+         * @property Clear color.
+         */
+        glm::vec4 m_clear_color;
+
+        /**
+         * @property If the clear color is known.
+         */
+        bool m_clear_color_known;
+
+        /**
+         * @property Issued and elided call counters.
+         */
+        Statistics m_stats;
+    };
+
+}
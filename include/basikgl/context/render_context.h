@@ -10,8 +10,12 @@
 #include <basikgl/context/context_properties.h>
 #include <basikgl/context/asset_manager.h>
 #include <basikgl/context/gl_tests.h>
+#include <basikgl/context/gl_state_cache.h>
+#include <basikgl/context/uniform_block_registry.h>
 #include <basikgl/window/window.h>
 #include <basikgl/render/renderer.h>
+#include <basikgl/render/batch_renderer.h>
+#include <basikgl/render/render_thread.h>
 #include <basikgl/color/color.h>
 
 /**
@@ -23,6 +27,9 @@ namespace bskgl {
     /// @brief Forward declaration for ContextManager class.
     class ContextManager;
 
+    /// @brief Forward declaration for CameraBase class.
+    class CameraBase;
+
     /**
      * @class RenderContext
      * @brief Represents a render context for OpenGL rendering.
@@ -45,6 +52,11 @@ namespace bskgl {
          */
         Renderer renderer;
 
+        /**
+         * @property Batch renderer associated with this context, used for drawing large amounts of quads.
+         */
+        BatchRenderer batch_renderer;
+
     private:
         /**
          * @brief Constructor
@@ -57,6 +69,7 @@ namespace bskgl {
     public:
         /**
          * @brief Move Constructor
+         * The render thread of the other context has to be stopped before moving it.
          */
         RenderContext(RenderContext&& other) noexcept;
 
@@ -133,9 +146,97 @@ namespace bskgl {
 
         /**
          * @brief Binds the current context.
+         * Makes the window current only if it isn't already, and makes this context's state cache active on the calling thread.
          */
         void bind() const;
 
+        /**
+         * @brief Returns the OpenGL state cache of this context.
+         * 
+         * @retval GLStateCache&
+         * @returns State cache, also reports how many redundant calls were elided.
+         */
+        [[nodiscard]]
+        GLStateCache& gl_state() const;
+
+        /**
+         * @brief Assigns a uniform block to a binding point and binds its buffer there.
+         * Every program declaring a block with this name reads the buffer, the binding is applied when the program is bound.
+         * 
+         * @param[in] block Name of the uniform block.
+         * @param[in] buffer UUID of the @class UniformBuffer backing the block, kept alive while the block is registered.
+         * 
+         * @retval uint32_t
+         * @returns Binding point of the block.
+         */
+        uint32_t register_uniform_block(const std::string& block, UUID buffer);
+
+        /**
+         * @brief Frees the binding point of a uniform block, programs keep the binding they were last bound with.
+         * 
+         * @param[in] block Name of the uniform block.
+         */
+        void unregister_uniform_block(const std::string& block);
+
+        /**
+         * @brief Fills the built-in per-frame uniform block, see @struct FrameUniforms.
+         * Called once per frame before drawing, a single upload serves every program declaring the block.
+         * 
+         * @param[in] camera Camera the frame is rendered with.
+         */
+        void update_frame_uniforms(const CameraBase& camera);
+
+        /**
+         * @retval UUID
+         * @returns UUID of the uniform buffer backing the built-in per-frame block.
+         */
+        [[nodiscard]]
+        UUID frame_uniform_buffer() const;
+
+        /**
+         * @brief Moves all the OpenGL work of this context to a dedicated render thread.
+         * From then on the renderer records draws into a command list which is replayed by the render thread on @fn RenderContext::end_frame(),
+         * while the calling thread keeps polling events and building the next frame.
+         * OpenGL work outside the renderer (updating buffers, textures etc.) has to go through @fn RenderContext::execute().
+         * 
+         * @param[in] frames_in_flight Number of command lists, 2 for double buffering and 3 for triple buffering.
+         */
+        void start_render_thread(uint32_t frames_in_flight = 2);
+
+        /**
+         * @brief Replays everything recorded so far, stops the render thread and makes the context current on the calling thread again.
+         */
+        void stop_render_thread();
+
+        /**
+         * @retval RenderThread*
+         * @returns Render thread of this context, nullptr if the context isn't threaded.
+         */
+        [[nodiscard]]
+        RenderThread* render_thread() const;
+
+        /**
+         * @brief Runs OpenGL work in order with the draws.
+         * Runs the task immediately unless the context is threaded, then it's recorded into the current frame,
+         * so it must capture everything it uses by value.
+         * 
+         * @param[in] task Task to run.
+         */
+        void execute(std::function<void()> task) const;
+
+        /**
+         * @brief Runs OpenGL work immediately and waits for it to finish, on the render thread if the context is threaded.
+         * The task runs before frames which haven't started replaying, used for creating assets.
+         * 
+         * @param[in] task Task to run.
+         */
+        void execute_sync(const std::function<void()>& task) const;
+
+        /**
+         * @brief Ends the frame, swaps the window buffers or hands the frame over to the render thread.
+         */
+        void end_frame() const;
+
     private:
         /**
          * @property UUID of this instance.
@@ -143,9 +244,24 @@ namespace bskgl {
         UUID m_uuid;
 
         /**
-         * @property Enabled tests.
+         * @property Shadowed OpenGL state of this context, also tracks enabled tests and the clear color.
+         */
+        mutable GLStateCache m_gl_state;
+
+        /**
+         * @property Binding points of the uniform blocks shared by the programs of this context, only used on the thread owning it.
+         */
+        UniformBlockRegistry m_uniform_blocks;
+
+        /**
+         * @property UUID of the uniform buffer backing the built-in per-frame block.
+         */
+        UUID m_frame_buffer = BSK_INVALID_UUID;
+
+        /**
+         * @property Render thread, nullptr if the context isn't threaded.
          */
-        GLTest m_enabled_tests;
+        std::unique_ptr<RenderThread> m_render_thread;
 
         /**
          * @property Clear Bits
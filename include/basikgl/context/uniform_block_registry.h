@@ -0,0 +1,207 @@
+/**
+ * @file context/uniform_block_registry.h
+ * @brief Contains the per-context registry assigning uniform blocks to binding points.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <basikgl/core/core.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /// @brief Forward declaration for RenderContext class.
+    class RenderContext;
+
+    /// @brief Forward declaration for UniformBuffer class.
+    class UniformBuffer;
+
+    /**
+     * @struct FrameUniforms
+     * @brief Contents of the built-in per-frame uniform block, laid out as declared in GLSL:
+     * @example layout(std140) uniform FrameData { mat4 u_view; mat4 u_projection; mat4 u_viewproj; float u_time; vec2 u_resolution; };
+     */
+    struct FrameUniforms {
+        /**
+         * @property View matrix of the camera.
+         */
+        glm::mat4 view = glm::mat4(1.0f);
+
+        /**
+         * @property Projection matrix of the camera.
+         */
+        glm::mat4 projection = glm::mat4(1.0f);
+
+        /**
+         * @property Projection matrix multiplied by the view matrix.
+         */
+        glm::mat4 view_projection = glm::mat4(1.0f);
+
+        /**
+         * @property Seconds since the library was initialized.
+         */
+        float time = 0.0f;
+
+        /**
+         * @property Padding, std140 aligns vec2 to 8 bytes.
+         */
+        float padding = 0.0f;
+
+        /**
+         * @property Size of the window in pixels.
+         */
+        glm::vec2 resolution = glm::vec2(0.0f);
+    };
+
+    static_assert(sizeof(FrameUniforms) == 208, "Frame uniforms have to match the std140 layout of the block.");
+
+    /**
+     * @class UniformBlockRegistry
+     * @brief Assigns uniform blocks to binding points by name and keeps their buffers bound.
+     * Programs bind the blocks they declare to the registered binding points when they are bound, so a buffer is uploaded once
+     * no matter how many programs read it. Only used on the thread owning the context.
+     */
+    class BSK_API UniformBlockRegistry final {
+        friend RenderContext;
+    public:
+        /**
+         * @property Name of the built-in per-frame block.
+         */
+        static constexpr const char* frame_block = "FrameData";
+
+        /**
+         * @property Binding point of the built-in per-frame block.
+         */
+        static constexpr uint32_t frame_binding = 0;
+
+        /**
+         * @property Binding point of a block which isn't registered.
+         */
+        static constexpr uint32_t none = UINT32_MAX;
+
+    private:
+        /**
+         * @brief Constructor
+         */
+        UniformBlockRegistry();
+
+    public:
+        /**
+         * @brief Move Constructor
+         */
+        UniformBlockRegistry(UniformBlockRegistry&& other) noexcept = default;
+
+        /**
+         * @brief Destructor
+         */
+        ~UniformBlockRegistry() = default;
+
+        UniformBlockRegistry(const UniformBlockRegistry& other) = delete;
+        UniformBlockRegistry& operator=(const UniformBlockRegistry& other) = delete;
+        UniformBlockRegistry& operator=(UniformBlockRegistry&& other) noexcept = delete;
+
+        /**
+         * @brief Returns the registry of the context bound on this thread.
+         *
+         * @retval const UniformBlockRegistry*
+         * @returns Registry of the current context, nullptr if no context has been bound through @fn RenderContext::bind().
+         */
+        [[nodiscard]]
+        static const UniformBlockRegistry* active();
+
+        /**
+         * @brief Returns the binding point of a block.
+         *
+         * @param[in] block Name of the block.
+         *
+         * @retval uint32_t
+         * @returns Binding point, @property UniformBlockRegistry::none if the block isn't registered.
+         */
+        [[nodiscard]]
+        uint32_t binding(const std::string& block) const;
+
+        /**
+         * @brief Returns the generation of the registry, changes whenever a block is registered or unregistered.
+         * Programs compare it against the generation they were bound with to skip rebinding their blocks.
+         *
+         * @retval uint64_t
+         * @returns Generation of the registry.
+         */
+        [[nodiscard]]
+        uint64_t generation() const;
+
+    private:
+        /**
+         * @brief Registers a block and binds its buffer, a block registered again keeps its binding point.
+         *
+         * @param[in] block Name of the block.
+         * @param[in] buffer Buffer backing the block.
+         *
+         * @retval uint32_t
+         * @returns Binding point of the block.
+         */
+        uint32_t m_register(const std::string& block, std::shared_ptr<UniformBuffer> buffer);
+
+        /**
+         * @brief Unregisters a block and frees its binding point.
+         *
+         * @param[in] block Name of the block.
+         */
+        void m_unregister(const std::string& block);
+
+    private:
+        /**
+         * @struct Entry
+         * @brief A registered block.
+         */
+        struct Entry {
+            /**
+             * @property Binding point of the block.
+             */
+            uint32_t binding = none;
+
+            /**
+             * @property Buffer backing the block, kept alive while it is registered.
+             */
+            std::shared_ptr<UniformBuffer> buffer;
+        };
+
+        /**
+         * @property Registry of the context bound on this thread.
+         */
+        static thread_local const UniformBlockRegistry* s_current;
+
+    private:
+        /**
+         * @property Registered blocks by name.
+         */
+        std::unordered_map<std::string, Entry> m_blocks;
+
+        /**
+         * @property Binding points freed by unregistered blocks.
+         */
+        std::vector<uint32_t> m_free_bindings;
+
+        /**
+         * @property Next binding point never handed out.
+         */
+        uint32_t m_next_binding;
+
+        /**
+         * @property Generation of the registry, starts at 1 so programs which never bound their blocks differ.
+         */
+        uint64_t m_generation;
+    };
+
+}
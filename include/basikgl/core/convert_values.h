@@ -8,6 +8,8 @@
 
 #include <basikgl/core/core.h>
 #include <basikgl/gfx/texture/texture.h>
+#include <basikgl/gfx/buffer_storage.h>
+#include <basikgl/gfx/indexbuffer.h>
 #include <basikgl/context/gl_tests.h>
 #include <basikgl/input/keyinput.h>
 #include <basikgl/input/mouseinput.h>
@@ -119,6 +121,28 @@ namespace bskgl::opengl {
     [[nodiscard]]
     int32_t BSK_API convert(GLClearBit clearbit);
 
+    /**
+     * @brief Converts given enums to OpenGL appropriate values.
+     * 
+     * @param[in] usage BufferUsage
+     * 
+     * @retval int32_t
+     * @returns OpenGL usage hint for mutable buffer storage.
+     */
+    [[nodiscard]]
+    int32_t BSK_API convert(BufferUsage usage);
+
+    /**
+     * @brief Converts given enums to OpenGL appropriate values.
+     * 
+     * @param[in] type IndexType
+     * 
+     * @retval int32_t
+     * @returns OpenGL index type for the draw calls.
+     */
+    [[nodiscard]]
+    int32_t BSK_API convert(IndexType type);
+
     /**
      * @brief Converts given OpenGL values to BasikGL appropriate enums.
      * 
@@ -36,6 +36,22 @@
     #define BSK_FUNCTION_SIGNATURE __func__
 #endif
 
+/**
+ * @def BSK_SIMD_SSE2
+ * @brief Defined if the compiler targets SSE2, enables the SIMD paths of the vertex and index encoders.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define BSK_SIMD_SSE2
+#endif
+
+/**
+ * @def BSK_SIMD_F16C
+ * @brief Defined if the compiler targets F16C, enables hardware half float conversion.
+ */
+#if defined(BSK_SIMD_SSE2) && (defined(__F16C__) || defined(__AVX2__))
+    #define BSK_SIMD_F16C
+#endif
+
 /**
  * @def BSK_LIB_VERSION_MAJOR
  * @brief Major version of current BasikGL library source code.
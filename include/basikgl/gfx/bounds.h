@@ -0,0 +1,106 @@
+/**
+ * @file gfx/bounds.h
+ * @brief Contains the bounding volumes of a mesh.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <basikgl/core/core.h>
+#include <basikgl/gfx/vertex.h>
+#include <basikgl/gfx/vertex_data.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /**
+     * @struct Bounds
+     * @brief Axis aligned bounding box and bounding sphere of a set of vertices.
+     */
+    struct BSK_API Bounds final {
+        /**
+         * @property Minimum corner of the bounding box.
+         */
+        glm::vec3 min = glm::vec3(0.0f);
+
+        /**
+         * @property Maximum corner of the bounding box.
+         */
+        glm::vec3 max = glm::vec3(0.0f);
+
+        /**
+         * @property Center of the bounding sphere, the center of the bounding box unless the bounds were expanded.
+         */
+        glm::vec3 center = glm::vec3(0.0f);
+
+        /**
+         * @property Radius of the bounding sphere.
+         */
+        float radius = 0.0f;
+
+        /**
+         * @brief Computes the bounds of vertex positions.
+         * The sphere is centered on the bounding box and only as large as the farthest vertex.
+         *
+         * @param[in] vertices Vector of vertices.
+         *
+         * @retval Bounds
+         * @returns Bounds of the vertices, all zero if there are no vertices.
+         */
+        [[nodiscard]]
+        static Bounds from_vertices(const std::vector<Vertex>& vertices);
+
+        /**
+         * @brief Computes the bounds of the positions of vertices in any layout.
+         *
+         * @param[in] vertices Vertex data, the position is the attribute at location 0.
+         *
+         * @retval Bounds
+         * @returns Bounds of the vertices, all zero if there are no vertices or they're released.
+         */
+        [[nodiscard]]
+        static Bounds from_vertices(const VertexData& vertices);
+
+        /**
+         * @brief Computes the bounds of the positions of packed vertices.
+         *
+         * @param[in] data Start of the vertices.
+         * @param[in] count Number of vertices.
+         * @param[in] layout Layout of a vertex, the position is the attribute at location 0.
+         *
+         * @retval Bounds
+         * @returns Bounds of the vertices, all zero if there are no vertices.
+         */
+        [[nodiscard]]
+        static Bounds from_vertices(const uint8_t* data, size_t count, const VertexLayout& layout);
+
+        /**
+         * @brief Grows the bounds to contain a point, the sphere keeps its center.
+         *
+         * @param[in] point Point to contain.
+         *
+         * @retval Bounds&
+         * @returns Reference to the updated variable.
+         */
+        Bounds& expand(const glm::vec3& point);
+
+        /**
+         * @brief Returns the bounds after a transformation, the box stays axis aligned.
+         *
+         * @param[in] model Model matrix.
+         *
+         * @retval Bounds
+         * @returns Conservative bounds of the transformed volume.
+         */
+        [[nodiscard]]
+        Bounds transformed(const glm::mat4& model) const;
+    };
+
+}
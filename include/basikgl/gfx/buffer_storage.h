@@ -0,0 +1,168 @@
+/**
+ * @file gfx/buffer_storage.h
+ * @brief Contains the GPU side storage shared by vertex and index buffers.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <basikgl/core/core.h>
+#include <basikgl/gfx/dirty_ranges.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /**
+     * @enum BufferUsage
+     * @brief How often the contents of a buffer are expected to change.
+     */
+    enum class BufferUsage : uint8_t {
+        /// @brief Uploaded once, backed by immutable storage, updates go through a staging copy.
+        Static,
+        /// @brief Updated occasionally, modified ranges are uploaded in place.
+        Dynamic,
+        /// @brief Rewritten every frame, the storage is orphaned on every upload.
+        Stream
+    };
+
+    /**
+     * @class BufferStorage
+     * @brief Owns an OpenGL buffer object and uploads to it according to its usage.
+     * Uploads address the buffer by name with glNamedBuffer* calls and bind nothing, so the bindings of the bound vertex array are left untouched.
+     * This class follows RAII.
+     */
+    class BSK_API BufferStorage final {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] usage Usage class of the buffer.
+         */
+        explicit BufferStorage(BufferUsage usage);
+
+        /**
+         * @brief Move Constructor
+         */
+        BufferStorage(BufferStorage&& other) noexcept;
+
+        /**
+         * @brief Move Assignment Operator
+         */
+        BufferStorage& operator=(BufferStorage&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         */
+        ~BufferStorage();
+
+        BufferStorage(const BufferStorage& other) = delete;
+        BufferStorage& operator=(const BufferStorage& other) = delete;
+
+        /**
+         * @brief Returns the OpenGL ID of the buffer.
+         * A static buffer gets a new ID when it's resized, immutable storage can't be reallocated.
+         *
+         * @retval uint32_t
+         * @returns OpenGL ID of the buffer.
+         */
+        [[nodiscard]]
+        uint32_t gl_id() const;
+
+        /**
+         * @retval BufferUsage
+         * @returns Usage class of the buffer.
+         */
+        [[nodiscard]]
+        BufferUsage usage() const;
+
+        /**
+         * @retval size_t
+         * @returns Size of the GPU side buffer in bytes.
+         */
+        [[nodiscard]]
+        size_t size() const;
+
+        /**
+         * @brief Returns if the next upload replaces the whole buffer.
+         *
+         * @param[in] size Size of the data in bytes.
+         * @param[in] dirty Modified ranges of elements.
+         *
+         * @retval bool
+         * @returns True if the size changes, if everything is dirty or if the buffer is streamed.
+         */
+        [[nodiscard]]
+        bool needs_full_upload(size_t size, const DirtyRanges& dirty) const;
+
+        /**
+         * @brief Uploads the dirty parts of the data.
+         * The whole buffer is uploaded if its size changes, if everything is dirty or if the buffer is streamed.
+         *
+         * @param[in] data Start of the CPU side data.
+         * @param[in] size Size of the data in bytes.
+         * @param[in] dirty Modified ranges of elements.
+         * @param[in] element_size Size of a single element in bytes.
+         *
+         * @retval bool
+         * @returns True if the whole buffer was uploaded.
+         */
+        bool upload(const void* data, size_t size, const DirtyRanges& dirty, size_t element_size);
+
+        /**
+         * @brief Reads the GPU side buffer back, this stalls until the draws writing it have finished.
+         *
+         * @param[out] data Destination, atleast @fn BufferStorage::size() bytes large.
+         */
+        void read(void* data) const;
+
+    private:
+        /**
+         * @brief Allocates the storage and uploads the whole data.
+         *
+         * @param[in] data Start of the CPU side data.
+         * @param[in] size Size of the data in bytes.
+         */
+        void m_allocate(const void* data, size_t size);
+
+        /**
+         * @brief Copies ranges into the immutable storage through a temporary staging buffer.
+         *
+         * @param[in] data Start of the CPU side data.
+         * @param[in] ranges Ranges of elements to copy.
+         * @param[in] element_size Size of a single element in bytes.
+         */
+        void m_stage(const void* data, const std::vector<DirtyRanges::Range>& ranges, size_t element_size);
+
+        /**
+         * @brief Deletes the buffer object.
+         */
+        void m_release();
+
+    private:
+        /**
+         * @property GPU side id of the buffer.
+         */
+        uint32_t m_glid;
+
+        /**
+         * @property Usage class of the buffer.
+         */
+        BufferUsage m_usage;
+
+        /**
+         * @property Size of the GPU side buffer in bytes.
+         */
+        size_t m_size;
+
+        /**
+         * @property If immutable storage has been created for the buffer object.
+         */
+        bool m_immutable;
+    };
+
+}
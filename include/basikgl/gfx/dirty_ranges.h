@@ -0,0 +1,112 @@
+/**
+ * @file gfx/dirty_ranges.h
+ * @brief Contains the interval set tracking which parts of a buffer need to be uploaded.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <basikgl/core/core.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /**
+     * @class DirtyRanges
+     * @brief Sorted set of disjoint half open ranges of modified elements.
+     * Ranges closer than the merge gap are merged, uploading a few clean elements is cheaper than an extra upload call.
+     */
+    class BSK_API DirtyRanges final {
+    public:
+        /**
+         * @struct Range
+         * @brief Half open range of elements [begin, end).
+         */
+        struct Range {
+            /**
+             * @property First element of the range.
+             */
+            size_t begin;
+
+            /**
+             * @property One past the last element of the range.
+             */
+            size_t end;
+        };
+
+        /**
+         * @property Default number of clean elements allowed between two ranges before they're kept separate.
+         */
+        static constexpr size_t default_merge_gap = 32;
+
+    public:
+        /**
+         * @brief Constructor
+         * Everything starts out dirty, nothing has been uploaded yet.
+         *
+         * @param[in] merge_gap Number of clean elements allowed between two merged ranges.
+         */
+        explicit DirtyRanges(size_t merge_gap = default_merge_gap);
+
+        /**
+         * @brief Marks a range of elements as dirty.
+         *
+         * @param[in] begin First element.
+         * @param[in] end One past the last element.
+         */
+        void mark(size_t begin, size_t end);
+
+        /**
+         * @brief Marks the whole buffer as dirty, used when the buffer has to be reallocated.
+         */
+        void mark_all();
+
+        /**
+         * @retval bool
+         * @returns True if the whole buffer is dirty.
+         */
+        [[nodiscard]]
+        bool all() const;
+
+        /**
+         * @retval bool
+         * @returns True if nothing is dirty.
+         */
+        [[nodiscard]]
+        bool empty() const;
+
+        /**
+         * @retval const std::vector<Range>&
+         * @returns Dirty ranges in ascending order, meaningless if the whole buffer is dirty.
+         */
+        [[nodiscard]]
+        const std::vector<Range>& ranges() const;
+
+        /**
+         * @brief Marks everything as clean.
+         */
+        void clear();
+
+    private:
+        /**
+         * @property Dirty ranges in ascending order.
+         */
+        std::vector<Range> m_ranges;
+
+        /**
+         * @property Number of clean elements allowed between two merged ranges.
+         */
+        size_t m_merge_gap;
+
+        /**
+         * @property If the whole buffer is dirty.
+         */
+        bool m_all;
+    };
+
+}
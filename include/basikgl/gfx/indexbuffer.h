@@ -7,9 +7,13 @@
 #pragma once
 
 #include <vector>
+#include <span>
 
 #include <basikgl/core/core.h>
 #include <basikgl/gfx/asset.h>
+#include <basikgl/gfx/dirty_ranges.h>
+#include <basikgl/gfx/buffer_storage.h>
+#include <basikgl/gfx/residency.h>
 
 /**
  * @namespace bskgl
@@ -20,9 +24,21 @@ namespace bskgl {
     /// @brief Forward declaration of AssetManager class.
     class AssetManager;
 
+    /**
+     * @enum IndexType
+     * @brief Type of the indices stored in the GPU side buffer.
+     */
+    enum class IndexType : uint8_t {
+        /// @brief 16 bit indices, used when every index fits.
+        UnsignedShort,
+        /// @brief 32 bit indices.
+        UnsignedInt
+    };
+
     /**
      * @class IndexBuffer
      * @brief Represents a opengl index buffer object
+     * The indices are edited as uint32_t, the GPU side buffer stores them as uint16_t whenever the largest index allows it.
      * This class follows RAII..
      */
     class BSK_API IndexBuffer final : public Asset {
@@ -33,16 +49,27 @@ namespace bskgl {
          * 
          * @param[in] uuid UUID of this instance.
          * @param[in] num_indices Number of indices.
+         * @param[in] usage Usage class of the GPU side buffer.
          */
-        IndexBuffer(UUID uuid, size_t num_indices);
+        IndexBuffer(UUID uuid, size_t num_indices, BufferUsage usage = BufferUsage::Dynamic);
 
         /**
          * @brief Constructor
          * 
          * @param[in] uuid UUID of this instance.
          * @param[in] indices Vector of indices.
+         * @param[in] usage Usage class of the GPU side buffer.
          */
-        IndexBuffer(UUID uuid, const std::vector<uint32_t>& indices);
+        IndexBuffer(UUID uuid, const std::vector<uint32_t>& indices, BufferUsage usage = BufferUsage::Dynamic);
+
+        /**
+         * @brief Constructor
+         * 
+         * @param[in] uuid UUID of this instance.
+         * @param[in] indices Vector of indices, moved into the buffer.
+         * @param[in] usage Usage class of the GPU side buffer.
+         */
+        IndexBuffer(UUID uuid, std::vector<uint32_t>&& indices, BufferUsage usage = BufferUsage::Dynamic);
 
     public:
         /**
@@ -78,8 +105,48 @@ namespace bskgl {
         [[nodiscard]]
         uint32_t gl_id() const;
 
+        /**
+         * @brief Returns the usage class of the buffer.
+         * 
+         * @retval BufferUsage
+         * @returns Usage class the GPU side buffer was created with.
+         */
+        [[nodiscard]]
+        BufferUsage usage() const;
+
+        /**
+         * @brief Returns the type of the indices in the GPU side buffer, pass it to the draw calls.
+         * The type is picked on every @fn IndexBuffer::sync() that reuploads the whole buffer.
+         * 
+         * @retval IndexType
+         * @returns Type of the uploaded indices.
+         */
+        [[nodiscard]]
+        IndexType index_type() const;
+
+        /**
+         * @brief Returns the residency policy of the buffer.
+         * 
+         * @retval Residency
+         * @returns Residency policy of the buffer.
+         */
+        [[nodiscard]]
+        Residency residency() const;
+
+        /**
+         * @brief Sets the residency policy of the buffer.
+         * A GPU only buffer releases its CPU side copy after every @fn IndexBuffer::sync(), the copy is released right away if it's already uploaded.
+         * 
+         * @param[in] residency Residency policy.
+         * 
+         * @retval IndexBuffer&
+         * @returns Reference to the updated variable.
+         */
+        IndexBuffer& set_residency(Residency residency);
+
         /**
          * @brief Returns vector of indices.
+         * If the CPU side copy was released, it's read back from the GPU first, which has to happen on the thread owning the context.
          * 
          * @retval const std::vector<uint32_t>&
          * @returns Vector of indices.
@@ -107,6 +174,29 @@ namespace bskgl {
          */
         IndexBuffer& set_indices(const std::vector<uint32_t>& indices);
 
+        /**
+         * @brief Sets the indices, moving them into the buffer.
+         * Setting the indices does not update the buffer stored in the GPU, call @fn IndexBuffer::sync() to update the GPU side buffer.
+         * 
+         * @param[in] indices Vector of indices.
+         * 
+         * @retval IndexBuffer&
+         * @returns Reference to the updated variable.
+         */
+        IndexBuffer& set_indices(std::vector<uint32_t>&& indices);
+
+        /**
+         * @brief Overwrites a range of indices.
+         * Only the modified range is uploaded on the next @fn IndexBuffer::sync(), nearby ranges are merged into one upload.
+         * 
+         * @param[in] offset Position of the first index to overwrite.
+         * @param[in] indices Indices to write, the range must lie within the buffer.
+         * 
+         * @retval IndexBuffer&
+         * @returns Reference to the updated variable.
+         */
+        IndexBuffer& update_indices(size_t offset, std::span<const uint32_t> indices);
+
         /**
          * @brief Binds the index buffer.
          */
@@ -114,7 +204,10 @@ namespace bskgl {
 
         /**
          * @brief Updates the GPU side buffer.
-         * This function binds the buffer, updates the buffer and then unbinds the buffer.
+         * The buffer is updated by name through direct state access, nothing is bound, so the element array binding of the bound vertex array is left untouched.
+         * The buffer is reallocated if the indices were replaced or resized, otherwise only the dirty ranges are uploaded.
+         * A partial update writing an index above 65535 into a 16 bit buffer reuploads the whole buffer as 32 bit.
+         * Resizing a static buffer replaces the buffer object, sync the vertex array using it to reattach it.
          * 
          * @retval IndexBuffer&
          * @returns Reference to the updated variable.
@@ -126,6 +219,18 @@ namespace bskgl {
          */
         static void unbind();
 
+    private:
+        /**
+         * @brief Releases the CPU side copy.
+         */
+        void m_release();
+
+        /**
+         * @brief Reads the released CPU side copy back from the GPU.
+         * Refused with an assertion on threads without a current context, the copy stays released.
+         */
+        void m_restore() const;
+
     private:
         /**
          * @property Unique Universal Identifier of this instance.
@@ -133,14 +238,35 @@ namespace bskgl {
         UUID m_uuid;
 
         /**
-         * @property GPU side id of this instance.
+         * @property GPU side storage of this instance.
          */
-        uint32_t m_glid;
+        BufferStorage m_storage;
 
         /**
          * @property Vector of indices stored in the buffer.
          */
-        std::vector<uint32_t> m_indices;
+        mutable std::vector<uint32_t> m_indices;
+
+        /**
+         * @property Ranges of indices modified since the last upload.
+         */
+        DirtyRanges m_dirty;
+
+        /**
+         * @property Type of the indices in the GPU side buffer.
+         */
+        IndexType m_type = IndexType::UnsignedInt;
+
+        /**
+         * @property Residency policy of the buffer.
+         */
+        Residency m_residency = Residency::Shadowed;
+
+        /**
+         * @property Bookkeeping of the released CPU side copy.
+         */
+        mutable ResidentCopy m_released;
+
     };
 
 }
\ No newline at end of file
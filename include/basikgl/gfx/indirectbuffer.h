@@ -0,0 +1,193 @@
+/**
+ * @file gfx/indirectbuffer.h
+ * @brief Contains the buffers feeding multi draw indirect calls.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <span>
+
+#include <basikgl/core/core.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /**
+     * @struct DrawElementsIndirectCommand
+     * @brief Parameters of one indexed draw, laid out the way glMultiDrawElementsIndirect reads them.
+     */
+    struct DrawElementsIndirectCommand {
+        /**
+         * @property Number of indices.
+         */
+        uint32_t count = 0;
+
+        /**
+         * @property Number of instances, 1 for a regular draw.
+         */
+        uint32_t instance_count = 1;
+
+        /**
+         * @property First index, in indices.
+         */
+        uint32_t first_index = 0;
+
+        /**
+         * @property Value added to every index.
+         */
+        int32_t base_vertex = 0;
+
+        /**
+         * @property First instance, offsets instanced attributes.
+         */
+        uint32_t base_instance = 0;
+    };
+
+    static_assert(sizeof(DrawElementsIndirectCommand) == 20, "Indirect commands have to be tightly packed.");
+
+    /**
+     * @class IndirectBuffer
+     * @brief Holds draw commands in a draw indirect buffer and per-draw data in a shader storage buffer.
+     * A range of commands is issued with a single glMultiDrawElementsIndirect, shaders fetch the data of their draw by gl_DrawID:
+     * @example layout(std430, binding = 0) readonly buffer DrawData { mat4 u_models[]; }; ... u_models[gl_DrawID]
+     * gl_DrawID restarts at zero for every call, so the data of a range is bound starting at its first draw.
+     * The buffers are created on the first upload, which has to happen on the thread owning the context.
+     * This class follows RAII.
+     */
+    class BSK_API IndirectBuffer final {
+    public:
+        /**
+         * @property Shader storage binding point the per-draw data is bound to by default.
+         */
+        static constexpr uint32_t default_binding = 0;
+
+        /**
+         * @property Largest shader storage offset alignment OpenGL allows, a multiple of the alignment of every driver.
+         * Aligning data ranges to it lets them be laid out without querying the context.
+         */
+        static constexpr size_t data_alignment = 256;
+
+        /**
+         * @struct Range
+         * @brief Commands issued by one multi draw call and the per-draw data they read.
+         */
+        struct Range {
+            /**
+             * @property First command, in commands.
+             */
+            size_t first_command = 0;
+
+            /**
+             * @property Number of commands.
+             */
+            size_t num_commands = 0;
+
+            /**
+             * @property Offset of the data of the first command in bytes, a multiple of @property IndirectBuffer::data_alignment.
+             */
+            size_t data_offset = 0;
+
+            /**
+             * @property Size of the data of the range in bytes, 0 if the draws read none.
+             */
+            size_t data_size = 0;
+        };
+
+    public:
+        /**
+         * @brief Constructor, no OpenGL objects are created until the first upload.
+         */
+        IndirectBuffer();
+
+        /**
+         * @brief Move Constructor
+         */
+        IndirectBuffer(IndirectBuffer&& other) noexcept;
+
+        /**
+         * @brief Move Assignment Operator
+         */
+        IndirectBuffer& operator=(IndirectBuffer&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         */
+        ~IndirectBuffer();
+
+        IndirectBuffer(const IndirectBuffer& other) = delete;
+        IndirectBuffer& operator=(const IndirectBuffer& other) = delete;
+
+        /**
+         * @retval uint32_t
+         * @returns OpenGL ID of the draw indirect buffer, 0 before the first upload.
+         */
+        [[nodiscard]]
+        uint32_t gl_id() const;
+
+        /**
+         * @retval uint32_t
+         * @returns OpenGL ID of the per-draw data buffer, 0 before the first upload.
+         */
+        [[nodiscard]]
+        uint32_t data_gl_id() const;
+
+        /**
+         * @brief Replaces the commands and the per-draw data.
+         * The buffers are orphaned, so draws still reading the previous upload aren't waited on.
+         *
+         * @param[in] commands Draw commands.
+         * @param[in] draw_data Per-draw data of every range, each starting at its @property Range::data_offset.
+         */
+        void upload(std::span<const DrawElementsIndirectCommand> commands, std::span<const uint8_t> draw_data);
+
+        /**
+         * @brief Issues a range of commands with a single call, the vertex array has to be bound and use 32 bit indices.
+         *
+         * @param[in] range Commands to issue and the data they read.
+         * @param[in] binding Shader storage binding point of the per-draw data.
+         */
+        void draw(const Range& range, uint32_t binding = default_binding) const;
+
+    private:
+        /**
+         * @brief Uploads data to a buffer, creating or growing it when needed.
+         *
+         * @param[in, out] buffer OpenGL ID of the buffer, created if 0.
+         * @param[in, out] capacity Size of the buffer in bytes.
+         * @param[in] data Data.
+         * @param[in] size Size of the data in bytes.
+         */
+        static void m_upload(uint32_t& buffer, size_t& capacity, const void* data, size_t size);
+
+        /**
+         * @brief Deletes the OpenGL objects.
+         */
+        void m_release();
+
+    private:
+        /**
+         * @property OpenGL ID of the draw indirect buffer.
+         */
+        uint32_t m_commands_glid;
+
+        /**
+         * @property OpenGL ID of the per-draw data buffer.
+         */
+        uint32_t m_data_glid;
+
+        /**
+         * @property Size of the draw indirect buffer in bytes.
+         */
+        size_t m_commands_capacity;
+
+        /**
+         * @property Size of the per-draw data buffer in bytes.
+         */
+        size_t m_data_capacity;
+    };
+
+}
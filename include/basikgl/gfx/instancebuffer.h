@@ -0,0 +1,231 @@
+/**
+ * @file gfx/instancebuffer.h
+ * @brief Contains the instance buffer holding per-instance vertex attributes.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <basikgl/core/core.h>
+#include <basikgl/gfx/asset.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /// @brief Forward declaration of AssetManager class.
+    class AssetManager;
+
+    /**
+     * @enum InstanceAttribute
+     * @brief Types of per-instance attributes, the value is the number of attribute locations used.
+     */
+    enum class InstanceAttribute : uint32_t {
+        Vec4 = 1,
+        Mat4 = 4
+    };
+
+    /**
+     * @class InstanceBuffer
+     * @brief Represents an opengl buffer object holding per-instance attributes.
+     * Every instance stores the attributes of the layout tightly packed as floats.
+     * This class follows RAII.
+     */
+    class BSK_API InstanceBuffer final : public Asset {
+        friend AssetManager;
+    public:
+        /**
+         * @property Default first attribute location, right after the attributes of @struct Vertex.
+         */
+        static constexpr uint32_t default_first_location = 3;
+
+    private:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] uuid UUID of this instance.
+         * @param[in] layout Attributes stored per instance.
+         * @param[in] num_instances Number of instances.
+         * @param[in] first_location Attribute location of the first attribute.
+         */
+        InstanceBuffer(UUID uuid, const std::vector<InstanceAttribute>& layout, size_t num_instances = 0, uint32_t first_location = default_first_location);
+
+        /**
+         * @brief Constructor
+         * Creates a buffer with a single mat4 attribute per instance, mostly used for model matrices.
+         *
+         * @param[in] uuid UUID of this instance.
+         * @param[in] transforms Per-instance transforms.
+         * @param[in] first_location Attribute location of the transform.
+         */
+        InstanceBuffer(UUID uuid, const std::vector<glm::mat4>& transforms, uint32_t first_location = default_first_location);
+
+    public:
+        /**
+         * @brief Move Constructor
+         */
+        InstanceBuffer(InstanceBuffer&& other) noexcept;
+
+        /**
+         * @brief Move Assignment Operator
+         */
+        InstanceBuffer& operator=(InstanceBuffer&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         */
+        ~InstanceBuffer();
+
+        InstanceBuffer(const InstanceBuffer& other) = delete;
+        InstanceBuffer& operator=(const InstanceBuffer& other) = delete;
+
+        /**
+         * @implements Asset::uuid()
+         */
+        [[nodiscard]]
+        UUID uuid() const override;
+
+        /**
+         * @brief Returns the OpenGL ID of the buffer.
+         *
+         * @retval uint32_t
+         * @returns OpenGL ID of the buffer.
+         */
+        [[nodiscard]]
+        uint32_t gl_id() const;
+
+        /**
+         * @retval const std::vector<InstanceAttribute>&
+         * @returns Attributes stored per instance.
+         */
+        [[nodiscard]]
+        const std::vector<InstanceAttribute>& layout() const;
+
+        /**
+         * @retval uint32_t
+         * @returns Attribute location of the first attribute.
+         */
+        [[nodiscard]]
+        uint32_t first_location() const;
+
+        /**
+         * @retval size_t
+         * @returns Size of a single instance in bytes.
+         */
+        [[nodiscard]]
+        size_t stride() const;
+
+        /**
+         * @retval size_t
+         * @returns Number of instances stored in the buffer.
+         */
+        [[nodiscard]]
+        size_t num_instances() const;
+
+        /**
+         * @brief Resizes the buffer, new instances are zero initialized.
+         * Resizing does not update the buffer stored in the GPU, call @fn InstanceBuffer::sync() to update the GPU side buffer.
+         *
+         * @param[in] num_instances Number of instances.
+         *
+         * @retval InstanceBuffer&
+         * @returns Reference to the updated variable.
+         */
+        InstanceBuffer& resize(size_t num_instances);
+
+        /**
+         * @brief Sets a vec4 attribute of an instance.
+         *
+         * @param[in] instance Index of the instance.
+         * @param[in] attribute Index of the attribute in the layout.
+         * @param[in] value Value of the attribute.
+         *
+         * @retval InstanceBuffer&
+         * @returns Reference to the updated variable.
+         */
+        InstanceBuffer& set_attribute(size_t instance, size_t attribute, const glm::vec4& value);
+
+        /**
+         * @brief Sets a mat4 attribute of an instance.
+         *
+         * @param[in] instance Index of the instance.
+         * @param[in] attribute Index of the attribute in the layout.
+         * @param[in] value Value of the attribute.
+         *
+         * @retval InstanceBuffer&
+         * @returns Reference to the updated variable.
+         */
+        InstanceBuffer& set_attribute(size_t instance, size_t attribute, const glm::mat4& value);
+
+        /**
+         * @brief Binds the instance buffer.
+         */
+        void bind() const;
+
+        /**
+         * @brief Updates the GPU side buffer.
+         * The buffer is updated by name through direct state access, nothing is bound, so the bindings of the bound vertex array are left untouched.
+         * The whole instance data is uploaded again.
+         *
+         * @retval InstanceBuffer&
+         * @returns Reference to the updated variable.
+         */
+        InstanceBuffer& sync();
+
+        /**
+         * @brief Unbinds the currently bound instance buffer.
+         */
+        static void unbind();
+
+    private:
+        /**
+         * @brief Returns the float offset of an attribute of an instance.
+         *
+         * @param[in] instance Index of the instance.
+         * @param[in] attribute Index of the attribute.
+         * @param[in] expected Expected type of the attribute.
+         *
+         * @retval size_t
+         * @returns Offset of the attribute in floats.
+         */
+        size_t m_offset_of(size_t instance, size_t attribute, InstanceAttribute expected) const;
+
+    private:
+        /**
+         * @property Unique Universal Identifier of this instance.
+         */
+        UUID m_uuid;
+
+        /**
+         * @property GPU side id of this instance.
+         */
+        uint32_t m_glid;
+
+        /**
+         * @property Attributes stored per instance.
+         */
+        std::vector<InstanceAttribute> m_layout;
+
+        /**
+         * @property Attribute location of the first attribute.
+         */
+        uint32_t m_first_location;
+
+        /**
+         * @property Number of floats per instance.
+         */
+        size_t m_floats_per_instance;
+
+        /**
+         * @property Per-instance data.
+         */
+        std::vector<float> m_data;
+    };
+
+}
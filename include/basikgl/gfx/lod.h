@@ -0,0 +1,41 @@
+/**
+ * @file gfx/lod.h
+ * @brief Contains the level of detail ranges of an index buffer.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <basikgl/core/core.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /**
+     * @struct LodLevel
+     * @brief A level of detail, a range of the index buffer drawing the mesh with fewer triangles.
+     * Levels are ordered from the full mesh to the coarsest one.
+     */
+    struct LodLevel {
+        /**
+         * @property First index of the level.
+         */
+        uint32_t first_index = 0;
+
+        /**
+         * @property Number of indices of the level.
+         */
+        uint32_t num_indices = 0;
+
+        /**
+         * @property Largest distance between the level and the full mesh in object space, 0 for the full mesh.
+         */
+        float error = 0.0f;
+
+        bool operator==(const LodLevel& other) const = default;
+    };
+
+}
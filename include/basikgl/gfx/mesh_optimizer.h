@@ -0,0 +1,158 @@
+/**
+ * @file gfx/mesh_optimizer.h
+ * @brief Contains the reordering passes making indexed meshes cheaper to draw.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <basikgl/core/core.h>
+#include <basikgl/gfx/vertex_data.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /// @brief Forward declaration of VertexArray class.
+    class VertexArray;
+
+    /**
+     * @class MeshOptimizer
+     * @brief Reorders triangle lists for the post transform vertex cache, for overdraw and for vertex fetch locality.
+     * The passes only reorder, the rendered image is unchanged apart from the draw order of overlapping triangles.
+     * Run them before the mesh is uploaded, they work on the CPU side copies.
+     */
+    class BSK_API MeshOptimizer final {
+    public:
+        /**
+         * @property Size of the FIFO cache used to measure ACMR, close to the reuse window of current GPUs.
+         */
+        static constexpr uint32_t default_cache_size = 16;
+
+        /**
+         * @property How much worse than the cache optimized order the overdraw pass may make the ACMR.
+         */
+        static constexpr float default_overdraw_threshold = 1.05f;
+
+        /**
+         * @struct Statistics
+         * @brief Result of @fn MeshOptimizer::optimize().
+         */
+        struct Statistics {
+            /**
+             * @property Average cache miss ratio, transformed vertices per triangle, of the input.
+             */
+            float acmr_before = 0.0f;
+
+            /**
+             * @property Average cache miss ratio of the output, 0.5 is the ideal for large regular grids.
+             */
+            float acmr_after = 0.0f;
+
+            /**
+             * @property Number of vertices of the input.
+             */
+            size_t vertices_before = 0;
+
+            /**
+             * @property Number of vertices of the output, vertices without a triangle are dropped.
+             */
+            size_t vertices_after = 0;
+        };
+
+    public:
+        MeshOptimizer() = delete;
+
+        /**
+         * @brief Runs every pass: vertex cache, overdraw and vertex fetch.
+         *
+         * @param[in, out] vertices Vertices of the mesh, reordered in place.
+         * @param[in, out] indices Triangle list, reordered in place.
+         * @param[in] overdraw_threshold ACMR increase the overdraw pass may trade for a better triangle order, 1 disables it.
+         *
+         * @retval Statistics
+         * @returns ACMR and vertex counts before and after, unchanged if the mesh is invalid.
+         */
+        static Statistics optimize(VertexData& vertices, std::vector<uint32_t>& indices, float overdraw_threshold = default_overdraw_threshold);
+
+        /**
+         * @brief Runs every pass on the vertices and indices of a vertex array.
+         * The new data is uploaded on the next @fn VertexArray::sync().
+         *
+         * @param[in, out] vertexarray Vertex array with an index buffer.
+         * @param[in] overdraw_threshold ACMR increase the overdraw pass may trade for a better triangle order, 1 disables it.
+         *
+         * @retval Statistics
+         * @returns ACMR and vertex counts before and after.
+         */
+        static Statistics optimize(VertexArray& vertexarray, float overdraw_threshold = default_overdraw_threshold);
+
+        /**
+         * @brief Reorders triangles so vertices are reused while they're in the post transform cache, Forsyth's algorithm.
+         *
+         * @param[in] indices Triangle list.
+         * @param[in] num_vertices Number of vertices the indices refer to.
+         *
+         * @retval std::vector<uint32_t>
+         * @returns Reordered triangle list.
+         */
+        [[nodiscard]]
+        static std::vector<uint32_t> optimize_vertex_cache(std::span<const uint32_t> indices, size_t num_vertices);
+
+        /**
+         * @brief Splits a cache optimized triangle list into clusters and sorts them so outward facing clusters are drawn first.
+         * Clusters end where the cache would be cold anyway, or where ending them costs less than the threshold.
+         *
+         * @param[in] indices Triangle list, usually the output of @fn MeshOptimizer::optimize_vertex_cache().
+         * @param[in] vertices Vertices, their positions are decoded through the layout.
+         * @param[in] threshold Allowed ACMR increase, 1.05 allows 5%.
+         *
+         * @retval std::vector<uint32_t>
+         * @returns Reordered triangle list.
+         */
+        [[nodiscard]]
+        static std::vector<uint32_t> optimize_overdraw(std::span<const uint32_t> indices, const VertexData& vertices, float threshold = default_overdraw_threshold);
+
+        /**
+         * @brief Reorders vertices in the order the triangles first use them and remaps the indices.
+         *
+         * @param[in, out] indices Triangle list, remapped in place.
+         * @param[in, out] vertices Vertices, replaced by the reordered ones.
+         *
+         * @retval size_t
+         * @returns Number of vertices kept, vertices without a triangle are dropped.
+         */
+        static size_t optimize_vertex_fetch(std::span<uint32_t> indices, VertexData& vertices);
+
+        /**
+         * @brief Simulates a FIFO post transform cache.
+         *
+         * @param[in] indices Triangle list.
+         * @param[in] num_vertices Number of vertices the indices refer to.
+         * @param[in] cache_size Number of cache entries.
+         *
+         * @retval float
+         * @returns Transformed vertices per triangle, between 0.5 and 3.
+         */
+        [[nodiscard]]
+        static float acmr(std::span<const uint32_t> indices, size_t num_vertices, uint32_t cache_size = default_cache_size);
+
+    private:
+        /**
+         * @brief Checks that the indices form triangles of existing vertices.
+         *
+         * @param[in] indices Triangle list.
+         * @param[in] num_vertices Number of vertices.
+         *
+         * @retval bool
+         * @returns True if the mesh can be optimized.
+         */
+        static bool m_validate(std::span<const uint32_t> indices, size_t num_vertices);
+    };
+
+}
@@ -0,0 +1,308 @@
+/**
+ * @file gfx/mesh_pool.h
+ * @brief Contains the pool storing many meshes in shared vertex and index buffers.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <span>
+
+#include <basikgl/core/core.h>
+#include <basikgl/core/error_handler.h>
+#include <basikgl/gfx/asset.h>
+#include <basikgl/gfx/range_allocator.h>
+#include <basikgl/gfx/vertex_data.h>
+#include <basikgl/gfx/vertex_layout.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /// @brief Forward declaration of AssetManager class.
+    class AssetManager;
+
+    /**
+     * @class MeshPool
+     * @brief Sub-allocates meshes of one vertex layout from a shared vertex buffer and a shared index buffer behind a single vertex array.
+     * Meshes are ranges drawn with a base vertex, so switching between them needs no binds.
+     * The buffers grow when they run out of space, the mesh ranges stay valid.
+     * Allocating, freeing and growing issue OpenGL calls, with a render thread they have to go through @fn RenderContext::execute().
+     * This class follows RAII..
+     */
+    class BSK_API MeshPool final : public Asset {
+        friend AssetManager;
+    public:
+        /**
+         * @property Number of vertices the pool starts with.
+         */
+        static constexpr size_t default_vertex_capacity = 1 << 16;
+
+        /**
+         * @property Number of indices the pool starts with.
+         */
+        static constexpr size_t default_index_capacity = 1 << 18;
+
+        /**
+         * @struct Mesh
+         * @brief Range of a mesh in the pool's buffers.
+         */
+        struct Mesh {
+            /**
+             * @property First vertex of the mesh, added to every index when drawing.
+             */
+            uint32_t base_vertex = 0;
+
+            /**
+             * @property Number of vertices.
+             */
+            uint32_t num_vertices = 0;
+
+            /**
+             * @property First index of the mesh.
+             */
+            uint32_t first_index = 0;
+
+            /**
+             * @property Number of indices.
+             */
+            uint32_t num_indices = 0;
+
+            /**
+             * @retval bool
+             * @returns False if the allocation failed.
+             */
+            [[nodiscard]]
+            bool is_valid() const {
+                return num_vertices != 0;
+            }
+
+            bool operator==(const Mesh& other) const = default;
+        };
+
+        /**
+         * @struct Statistics
+         * @brief Occupancy of the pool.
+         */
+        struct Statistics {
+            /**
+             * @property Occupancy and fragmentation of the vertex buffer, in vertices.
+             */
+            RangeAllocator::Statistics vertices;
+
+            /**
+             * @property Occupancy and fragmentation of the index buffer, in indices.
+             */
+            RangeAllocator::Statistics indices;
+
+            /**
+             * @property Number of meshes in the pool.
+             */
+            size_t num_meshes = 0;
+
+            /**
+             * @property Number of times a buffer was grown.
+             */
+            size_t grows = 0;
+        };
+
+    private:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] uuid UUID of this instance.
+         * @param[in] layout Layout of the vertices of every mesh.
+         * @param[in] vertex_capacity Number of vertices the vertex buffer starts with.
+         * @param[in] index_capacity Number of indices the index buffer starts with.
+         */
+        MeshPool(UUID uuid, VertexLayout layout, size_t vertex_capacity = default_vertex_capacity, size_t index_capacity = default_index_capacity);
+
+    public:
+        /**
+         * @brief Move Constructor
+         */
+        MeshPool(MeshPool&& other) noexcept;
+
+        /**
+         * @brief Move Assignment Operator
+         */
+        MeshPool& operator=(MeshPool&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         */
+        ~MeshPool();
+
+        MeshPool(const MeshPool& other) = delete;
+        MeshPool& operator=(const MeshPool& other) = delete;
+
+        /**
+         * @implements Asset::uuid()
+         */
+        [[nodiscard]]
+        UUID uuid() const override;
+
+        /**
+         * @brief Returns the OpenGL ID of the vertex array.
+         *
+         * @retval uint32_t
+         * @returns OpenGL ID of the vertex array.
+         */
+        [[nodiscard]]
+        uint32_t gl_id() const;
+
+        /**
+         * @retval const VertexLayout&
+         * @returns Layout of the vertices.
+         */
+        [[nodiscard]]
+        const VertexLayout& layout() const;
+
+        /**
+         * @brief Uploads a mesh into the pool.
+         *
+         * @param[in] vertices Vertices, their layout must match the pool.
+         * @param[in] indices Triangle list relative to the first vertex of the mesh.
+         *
+         * @retval Mesh
+         * @returns Range of the mesh, invalid if the data was.
+         */
+        Mesh allocate(const VertexData& vertices, std::span<const uint32_t> indices);
+
+        /**
+         * @brief Uploads a mesh into the pool.
+         *
+         * @tparam V Vertex type, its format must match the layout of the pool.
+         *
+         * @param[in] vertices Vertices.
+         * @param[in] indices Triangle list relative to the first vertex of the mesh.
+         *
+         * @retval Mesh
+         * @returns Range of the mesh, invalid if the data was.
+         */
+        template <VertexType V>
+        Mesh allocate(std::span<const V> vertices, std::span<const uint32_t> indices) {
+            BSK_VERIFY(V::Format::layout() == m_layout, "Vertex type doesn't match the layout of the mesh pool.");
+            return this->m_allocate(reinterpret_cast<const uint8_t*>(vertices.data()), vertices.size(), indices);
+        }
+
+        /**
+         * @brief Frees the ranges of a mesh, they're reused by later allocations.
+         *
+         * @param[in] mesh Mesh returned by @fn MeshPool::allocate().
+         */
+        void free(const Mesh& mesh);
+
+        /**
+         * @brief Binds the vertex array of the pool, every mesh is drawn with it bound.
+         */
+        void bind() const;
+
+        /**
+         * @brief Draws a mesh, the pool has to be bound.
+         *
+         * @param[in] mesh Mesh to draw.
+         * @param[in] instances Number of instances, zero for a regular draw.
+         */
+        void draw(const Mesh& mesh, size_t instances = 0) const;
+
+        /**
+         * @brief Returns the occupancy of the pool.
+         *
+         * @retval Statistics
+         * @returns Occupancy and fragmentation of both buffers.
+         */
+        [[nodiscard]]
+        Statistics statistics() const;
+
+        /**
+         * @brief Unbinds the currently bound vertex array.
+         */
+        static void unbind();
+
+    private:
+        /**
+         * @brief Uploads a mesh into the pool.
+         *
+         * @param[in] vertices Start of the vertices, laid out like the pool.
+         * @param[in] num_vertices Number of vertices.
+         * @param[in] indices Triangle list relative to the first vertex of the mesh.
+         *
+         * @retval Mesh
+         * @returns Range of the mesh, invalid if the data was.
+         */
+        Mesh m_allocate(const uint8_t* vertices, size_t num_vertices, std::span<const uint32_t> indices);
+
+        /**
+         * @brief Allocates a range, growing the buffer if no free range is large enough.
+         *
+         * @param[in, out] allocator Allocator of the buffer.
+         * @param[in, out] buffer OpenGL ID of the buffer, replaced when it grows.
+         * @param[in] element_size Size of an element of the buffer in bytes.
+         * @param[in] size Number of elements to allocate.
+         *
+         * @retval size_t
+         * @returns First element of the range.
+         */
+        size_t m_reserve(RangeAllocator& allocator, uint32_t& buffer, size_t element_size, size_t size);
+
+        /**
+         * @brief Attaches the buffers to the vertex array, the attribute formats set on creation stay.
+         */
+        void m_attach();
+
+        /**
+         * @brief Deletes the OpenGL objects.
+         */
+        void m_release();
+
+    private:
+        /**
+         * @property Unique Universal Identifier of this instance.
+         */
+        UUID m_uuid;
+
+        /**
+         * @property Layout of the vertices.
+         */
+        VertexLayout m_layout;
+
+        /**
+         * @property OpenGL ID of the vertex array.
+         */
+        uint32_t m_vao;
+
+        /**
+         * @property OpenGL ID of the vertex buffer.
+         */
+        uint32_t m_vbo;
+
+        /**
+         * @property OpenGL ID of the index buffer.
+         */
+        uint32_t m_ibo;
+
+        /**
+         * @property Allocator of the vertex buffer, in vertices.
+         */
+        RangeAllocator m_vertex_allocator;
+
+        /**
+         * @property Allocator of the index buffer, in indices.
+         */
+        RangeAllocator m_index_allocator;
+
+        /**
+         * @property Number of meshes in the pool.
+         */
+        size_t m_num_meshes;
+
+        /**
+         * @property Number of times a buffer was grown.
+         */
+        size_t m_grows;
+    };
+
+}
@@ -0,0 +1,109 @@
+/**
+ * @file gfx/program_binary_cache.h
+ * @brief Contains the on-disk cache of linked shader program binaries.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+#include <basikgl/core/core.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /// @brief Forward declaration of Shader class.
+    class Shader;
+
+    /**
+     * @class ProgramBinaryCache
+     * @brief Stores linked programs on disk and loads them instead of compiling on later runs.
+     * Binaries are keyed by a hash of the sources and the vendor, renderer and version strings of the driver,
+     * so a driver update or an edited source compiles again. Programs the driver rejects are compiled as well.
+     * The cache is off until @fn ProgramBinaryCache::enable() is called, which has to happen before shaders are created.
+     */
+    class BSK_API ProgramBinaryCache final {
+        friend Shader;
+    public:
+        ProgramBinaryCache() = delete;
+
+        /**
+         * @brief Enables the cache.
+         *
+         * @param[in] directory Directory the binaries are stored in, created if it doesn't exist.
+         */
+        static void enable(const std::filesystem::path& directory);
+
+        /**
+         * @brief Disables the cache, stored binaries are kept.
+         */
+        static void disable();
+
+        /**
+         * @retval bool
+         * @returns True if the cache is enabled.
+         */
+        [[nodiscard]]
+        static bool enabled();
+
+        /**
+         * @retval const std::filesystem::path&
+         * @returns Directory the binaries are stored in, empty if the cache is disabled.
+         */
+        [[nodiscard]]
+        static const std::filesystem::path& directory();
+
+    private:
+        /**
+         * @brief Computes the key of a program, needs a current context to query the driver strings.
+         *
+         * @param[in] vert_source Vertex shader source.
+         * @param[in] pixel_source Pixel (fragment) shader source.
+         *
+         * @retval uint64_t
+         * @returns Key of the program.
+         */
+        static uint64_t m_key(const std::string& vert_source, const std::string& pixel_source);
+
+        /**
+         * @brief Loads a stored binary into a program.
+         *
+         * @param[in] program OpenGL ID of the program.
+         * @param[in] key Key of the program.
+         *
+         * @retval bool
+         * @returns True if the program is linked from the binary, false if it has to be compiled.
+         */
+        static bool m_load(uint32_t program, uint64_t key);
+
+        /**
+         * @brief Stores the binary of a linked program, replacing the stored one.
+         *
+         * @param[in] program OpenGL ID of the program, linked with the retrievable hint.
+         * @param[in] key Key of the program.
+         */
+        static void m_store(uint32_t program, uint64_t key);
+
+        /**
+         * @brief Returns the file holding the binary of a program.
+         *
+         * @param[in] key Key of the program.
+         *
+         * @retval std::filesystem::path
+         * @returns Path of the file.
+         */
+        static std::filesystem::path m_path(uint64_t key);
+
+    private:
+        /**
+         * @property Directory the binaries are stored in, empty if the cache is disabled.
+         */
+        static std::filesystem::path s_directory;
+    };
+
+}
@@ -0,0 +1,152 @@
+/**
+ * @file gfx/range_allocator.h
+ * @brief Contains the offset allocator sub-allocating ranges of shared buffers.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <map>
+
+#include <basikgl/core/core.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /**
+     * @class RangeAllocator
+     * @brief Hands out ranges of a linear address space, the memory itself lives elsewhere (usually a GPU buffer).
+     * Free ranges are kept in a free list ordered by offset, neighbours are coalesced on free, allocation picks the best fit.
+     */
+    class BSK_API RangeAllocator final {
+    public:
+        /**
+         * @property Offset returned when no free range is large enough.
+         */
+        static constexpr size_t invalid = std::numeric_limits<size_t>::max();
+
+        /**
+         * @struct Statistics
+         * @brief Occupancy and fragmentation of the address space.
+         */
+        struct Statistics {
+            /**
+             * @property Size of the address space.
+             */
+            size_t capacity = 0;
+
+            /**
+             * @property Allocated size.
+             */
+            size_t used = 0;
+
+            /**
+             * @property Size of the largest free range, the largest allocation that can succeed.
+             */
+            size_t largest_free = 0;
+
+            /**
+             * @property Number of free ranges.
+             */
+            size_t free_ranges = 0;
+
+            /**
+             * @property Share of the free space outside of the largest free range, 0 if the free space is contiguous.
+             */
+            float fragmentation = 0.0f;
+        };
+
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] capacity Size of the address space, all of it is free.
+         */
+        explicit RangeAllocator(size_t capacity = 0);
+
+        /**
+         * @brief Allocates a range.
+         *
+         * @param[in] size Size of the range, must not be zero.
+         *
+         * @retval size_t
+         * @returns Offset of the range, @property RangeAllocator::invalid if no free range is large enough.
+         */
+        [[nodiscard]]
+        size_t allocate(size_t size);
+
+        /**
+         * @brief Frees a range returned by @fn RangeAllocator::allocate().
+         *
+         * @param[in] offset Offset of the range.
+         * @param[in] size Size the range was allocated with.
+         */
+        void free(size_t offset, size_t size);
+
+        /**
+         * @brief Extends the address space, the new space is free and merges with a free range at the old end.
+         *
+         * @param[in] capacity New size of the address space, smaller values are ignored.
+         */
+        void grow(size_t capacity);
+
+        /**
+         * @retval size_t
+         * @returns Size of the address space.
+         */
+        [[nodiscard]]
+        size_t capacity() const;
+
+        /**
+         * @brief Returns the occupancy of the address space.
+         *
+         * @retval Statistics
+         * @returns Used and free space and the fragmentation.
+         */
+        [[nodiscard]]
+        Statistics statistics() const;
+
+    private:
+        /**
+         * @brief Adds a free range to both indices.
+         *
+         * @param[in] offset Offset of the range.
+         * @param[in] size Size of the range.
+         */
+        void m_insert(size_t offset, size_t size);
+
+        /**
+         * @brief Removes a free range from both indices.
+         *
+         * @param[in] range Iterator into the offset index.
+         */
+        void m_erase(std::map<size_t, size_t>::iterator range);
+
+    private:
+        /**
+         * @property Free ranges, size by offset.
+         */
+        std::map<size_t, size_t> m_free;
+
+        /**
+         * @property Free ranges, offset by size, used for the best fit search.
+         */
+        std::multimap<size_t, size_t> m_free_by_size;
+
+        /**
+         * @property Size of the address space.
+         */
+        size_t m_capacity;
+
+        /**
+         * @property Allocated size.
+         */
+        size_t m_used;
+    };
+
+}
@@ -0,0 +1,188 @@
+/**
+ * @file gfx/residency.h
+ * @brief Contains the residency policy of assets and the accounting of released CPU side copies.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include <basikgl/core/core.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /**
+     * @enum Residency
+     * @brief Where the data of an asset is kept once it's uploaded.
+     */
+    enum class Residency : uint8_t {
+        /// @brief A CPU side copy is kept alongside the GPU data.
+        Shadowed,
+        /// @brief The CPU side copy is released after upload, it's read back or reloaded when requested again.
+        /// Reading back needs the context, with the render thread running request the data inside @fn RenderContext::execute_sync().
+        GPUOnly
+    };
+
+    /**
+     * @class ResidencyTracker
+     * @brief Accounts for the heap memory saved by releasing CPU side copies of assets.
+     * The counters are shared by every context and safe to update from any thread.
+     */
+    class BSK_API ResidencyTracker final {
+    public:
+        /**
+         * @struct Statistics
+         * @brief Snapshot of the residency counters.
+         */
+        struct Statistics {
+            /**
+             * @property Bytes of CPU side copies currently released.
+             */
+            size_t released_bytes = 0;
+
+            /**
+             * @property Total bytes read back from the GPU or reloaded from source.
+             */
+            size_t restored_bytes = 0;
+
+            /**
+             * @property Number of times a released copy had to be read back or reloaded.
+             */
+            size_t restores = 0;
+        };
+
+    public:
+        ResidencyTracker() = delete;
+
+        /**
+         * @brief Returns a snapshot of the counters.
+         *
+         * @retval Statistics
+         * @returns Released and restored byte counts.
+         */
+        [[nodiscard]]
+        static Statistics statistics();
+
+        /**
+         * @brief Records a CPU side copy being released.
+         *
+         * @param[in] bytes Size of the released copy.
+         */
+        static void on_released(size_t bytes);
+
+        /**
+         * @brief Records a released copy being read back or reloaded.
+         *
+         * @param[in] bytes Size of the restored copy.
+         */
+        static void on_restored(size_t bytes);
+
+        /**
+         * @brief Records a released copy being dropped without a restore, when the asset is destroyed or its data replaced.
+         *
+         * @param[in] bytes Size of the dropped copy.
+         */
+        static void on_discarded(size_t bytes);
+
+    private:
+        /**
+         * @property Bytes of CPU side copies currently released.
+         */
+        static std::atomic<size_t> s_released_bytes;
+
+        /**
+         * @property Total bytes read back or reloaded.
+         */
+        static std::atomic<size_t> s_restored_bytes;
+
+        /**
+         * @property Number of restores.
+         */
+        static std::atomic<size_t> s_restores;
+    };
+
+    /**
+     * @class ResidentCopy
+     * @brief Bookkeeping of the CPU side copy of a @fn Residency::GPUOnly asset.
+     * Holds the size of the released copy and reports every change to @fn ResidencyTracker, a copy still released when the
+     * guard is destroyed or replaced counts as discarded.
+     */
+    class BSK_API ResidentCopy final {
+    public:
+        ResidentCopy() = default;
+
+        ResidentCopy(const ResidentCopy&) = delete;
+        ResidentCopy& operator=(const ResidentCopy&) = delete;
+
+        /**
+         * @brief Takes over the released copy of another guard.
+         */
+        ResidentCopy(ResidentCopy&& other) noexcept;
+
+        /**
+         * @brief Discards the copy this guard released and takes over the one of another guard.
+         */
+        ResidentCopy& operator=(ResidentCopy&& other) noexcept;
+
+        /**
+         * @brief Discards the copy if it's still released.
+         */
+        ~ResidentCopy();
+
+        /**
+         * @retval bool
+         * @returns True if the CPU side copy is released.
+         */
+        [[nodiscard]]
+        bool released() const;
+
+        /**
+         * @retval size_t
+         * @returns Size in bytes of the released copy, zero if the copy is held.
+         */
+        [[nodiscard]]
+        size_t bytes() const;
+
+        /**
+         * @brief Records the copy being released, the asset frees it itself.
+         *
+         * @param[in] bytes Size of the released copy.
+         */
+        void release(size_t bytes);
+
+        /**
+         * @brief Checks if the released copy can be read back from the GPU, which needs the context current on the calling thread.
+         * The app thread has no context once the render thread owns it, so an assertion is raised there.
+         *
+         * @param[in] what What is read back, used in the assertion message.
+         *
+         * @retval bool
+         * @returns True if the copy is released and the calling thread owns a context.
+         */
+        [[nodiscard]]
+        bool can_read_back(const std::string& what) const;
+
+        /**
+         * @brief Records the copy being read back or reloaded.
+         */
+        void restored();
+
+        /**
+         * @brief Records the copy being dropped without a restore, when the asset data is replaced. Does nothing if the copy is held.
+         */
+        void discard();
+
+    private:
+        /**
+         * @property Size in bytes of the released copy, zero if the copy is held.
+         */
+        size_t m_bytes = 0;
+    };
+
+}
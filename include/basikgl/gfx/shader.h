@@ -5,11 +5,15 @@
  */
 #pragma once
 
+#include <atomic>
 #include <filesystem>
+#include <mutex>
 #include <string>
 #include <variant>
 #include <unordered_map>
+#include <unordered_set>
 #include <optional>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -80,6 +84,37 @@ namespace bskgl {
             /// @brief BasikGL types
             Color
         >;
+
+        /**
+         * @property Uniform values by name.
+         */
+        using Uniforms = std::unordered_map<std::string, UniformValue>;
+
+        /**
+         * @struct UniformInfo
+         * @brief An active uniform of the linked program, found by reflection.
+         */
+        struct UniformInfo {
+            /**
+             * @property Name of the uniform, arrays are named without the [0] suffix.
+             */
+            std::string name;
+
+            /**
+             * @property Location of the uniform.
+             */
+            int32_t location = -1;
+
+            /**
+             * @property OpenGL type of the uniform, @example GL_FLOAT_MAT4.
+             */
+            uint32_t type = 0;
+
+            /**
+             * @property Number of array elements, 1 if the uniform isn't an array.
+             */
+            int32_t size = 0;
+        };
     
     private:
         /**
@@ -88,8 +123,9 @@ namespace bskgl {
          * @param[in] uuid UUID of this instance.
          * @param[in] vertex_source Vertex source code.
          * @param[in] pixel_source Pixel source code.
+         * @param[in] deferred If true, compilation is only submitted and the program can't be bound until @fn Shader::ready().
          */
-        Shader(UUID uuid, const std::string& vertex_source, const std::string& pixel_source);
+        Shader(UUID uuid, const std::string& vertex_source, const std::string& pixel_source, bool deferred = false);
 
         /**
          * @brief Constructor
@@ -97,8 +133,9 @@ namespace bskgl {
          * @param[in] uuid UUID of this instance.
          * @param[in] vertex_path Vertex source file path.
          * @param[in] pixel_path Pixel source file path
+         * @param[in] deferred If true, compilation is only submitted and the program can't be bound until @fn Shader::ready().
          */
-        Shader(UUID uuid, const std::filesystem::path& vertex_path, const std::filesystem::path& pixel_path);
+        Shader(UUID uuid, const std::filesystem::path& vertex_path, const std::filesystem::path& pixel_path, bool deferred = false);
 
         Shader(const Shader& other) = delete;
         Shader& operator=(const Shader& other) = delete;
@@ -198,6 +235,9 @@ namespace bskgl {
 
         /**
          * @brief Sets the uniform value.
+         * Setting the value the uniform already has does nothing, otherwise only this uniform is uploaded on the next bind.
+         * A uniform the program doesn't have is still stored, a warning is raised the first time it is set.
+         * Safe to call while the render thread finishes a program created through @fn AssetManager::create_asset_async().
          * 
          * @param[in] name Uniform name.
          * @param[in] value Uniform value.
@@ -228,9 +268,77 @@ namespace bskgl {
         std::optional<UniformValue> uniform_value(const std::string& name) const;
 
         /**
-         * @brief Binds the shader program, also updates the shader with all the stored uniform values.
+         * @brief Returns all the stored uniform values.
+         * 
+         * @retval const Uniforms&
+         * @returns Uniform values by name.
          */
-        void bind() const;
+        [[nodiscard]]
+        const Uniforms& uniforms() const;
+
+        /**
+         * @brief Returns the active uniforms of the program, found when it was linked.
+         * Uniforms in uniform blocks have no location and aren't listed.
+         * Read on the thread owning the context, or once the program is @fn Shader::ready().
+         * 
+         * @retval const std::vector<UniformInfo>&
+         * @returns Active uniforms.
+         */
+        [[nodiscard]]
+        const std::vector<UniformInfo>& active_uniforms() const;
+
+        /**
+         * @brief Looks up an active uniform.
+         * Read on the thread owning the context, or once the program is @fn Shader::ready().
+         * 
+         * @param[in] name Uniform name.
+         * 
+         * @retval const UniformInfo*
+         * @returns Location, type and size of the uniform, nullptr if the program doesn't have it.
+         */
+        [[nodiscard]]
+        const UniformInfo* uniform_info(const std::string& name) const;
+
+        /**
+         * @brief Returns the active uniform blocks of the linked program.
+         * Blocks registered with @fn RenderContext::register_uniform_block() are bound to their binding point when the program is bound.
+         * 
+         * @retval const std::vector<std::string>&
+         * @returns Names of the blocks, indexed by block index.
+         */
+        [[nodiscard]]
+        const std::vector<std::string>& uniform_blocks() const;
+
+        /**
+         * @brief Checks if the program is linked, finishing it once the driver is done.
+         * Programs created through @fn AssetManager::create_asset_async() are compiled in the background if the driver supports
+         * GL_KHR_parallel_shader_compile, otherwise the first check waits for the driver. Called on the thread owning the context.
+         * 
+         * @retval bool
+         * @returns True if the program can be bound.
+         */
+        bool ready();
+
+        /**
+         * @brief Binds the shader program, also updates the shader with the stored uniform values.
+         * Only uniforms set since the last bind are uploaded, unless a snapshot was bound in between.
+         * 
+         * @retval bool
+         * @returns False if the program isn't @fn Shader::ready() yet, nothing is bound then.
+         */
+        bool bind();
+
+        /**
+         * @brief Binds the shader program and updates it with the given uniform values instead of the stored ones.
+         * Used to replay draws with a snapshot of the uniforms taken when the draw was recorded.
+         * Values the program already holds aren't uploaded again.
+         * 
+         * @param[in] uniforms Uniform values by name.
+         * 
+         * @retval bool
+         * @returns False if the program isn't @fn Shader::ready() yet, nothing is bound then.
+         */
+        bool bind(const Uniforms& uniforms);
 
         /**
          * @brief Unbinds currently bound shader program.
@@ -239,17 +347,44 @@ namespace bskgl {
 
     private:
         /**
-         * @brief Compiles, attaches and links the program.
+         * @brief Compiles, attaches and links the program, or loads it from the program binary cache if it's enabled.
+         * Empty sources keep the current source of the stage.
          * 
          * @param[in] vert_source Vertex shader source.
          * @param[in] pixel_source Pixel (fragment) shader source.
+         * @param[in] deferred If true, returns once the driver has the work, the program is finished by @fn Shader::ready().
+         */
+        void m_compile(const std::string& vert_source, const std::string& pixel_source, bool deferred = false);
+
+        /**
+         * @brief Checks the compile and link status of a submitted program, reflects and validates it.
+         */
+        void m_finish();
+
+        /**
+         * @brief Builds the table of active uniforms of the linked program.
+         */
+        void m_reflect();
+
+        /**
+         * @brief Uploads the given uniform values that differ from the ones the program holds, uniforms the program doesn't have are skipped.
+         * 
+         * @param[in] uniforms Uniform values by name.
+         */
+        void m_apply_uniforms(const Uniforms& uniforms) const;
+
+        /**
+         * @brief Uploads a uniform value unless the program already holds it.
+         * 
+         * @param[in] slot Index into the uniform table.
+         * @param[in] value Uniform value.
          */
-        void m_compile(const std::string& vert_source, const std::string& pixel_source);
+        void m_apply_uniform(uint32_t slot, const UniformValue& value) const;
 
         /**
-         * @brief Sets all the uniform values.
+         * @brief Binds the uniform blocks of the program to the binding points of the current context's registry, if it changed since the last bind.
          */
-        void m_apply_uniforms() const;
+        void m_bind_uniform_blocks() const;
 
     private:
         /**
@@ -272,10 +407,86 @@ namespace bskgl {
          */
         uint32_t m_pixel_glid;
 
+        /**
+         * @property Current vertex shader source, kept to key the program binary cache and to compile the stage after a cache hit.
+         */
+        std::string m_vert_source;
+
+        /**
+         * @property Current pixel (fragment) shader source.
+         */
+        std::string m_pixel_source;
+
+        /**
+         * @property If the shader objects hold the current sources compiled, false if the program was loaded from a binary.
+         */
+        bool m_stages_compiled = false;
+
+        /**
+         * @property If the program was submitted for linking and isn't finished yet.
+         * Atomic since the render thread finishes programs while the application thread sets uniforms.
+         */
+        std::atomic<bool> m_pending = false;
+
+        /**
+         * @property Guards the stored uniforms and the uniform table against the program being finished on another thread.
+         */
+        mutable std::mutex m_uniform_mutex;
+
+        /**
+         * @property Key the program is stored under in the program binary cache once linked, std::nullopt if the cache is disabled.
+         */
+        std::optional<uint64_t> m_binary_key;
+
         /**
          * @property Uniform values stored in the shader.
          */
-        std::unordered_map<std::string, UniformValue> m_uniforms;
+        Uniforms m_uniforms;
+
+        /**
+         * @property Active uniforms of the linked program.
+         */
+        std::vector<UniformInfo> m_uniform_table;
+
+        /**
+         * @property Index into the uniform table by name.
+         */
+        std::unordered_map<std::string, uint32_t> m_uniform_slots;
+
+        /**
+         * @property Names of missing uniforms that were already warned about.
+         */
+        std::unordered_set<std::string> m_missing_uniforms;
+
+        /**
+         * @property Value every slot of the uniform table holds in the program, std::nullopt if it was never uploaded.
+         */
+        mutable std::vector<std::optional<UniformValue>> m_resident;
+
+        /**
+         * @property Slots whose stored value changed since the last bind with the stored uniforms.
+         */
+        mutable std::vector<uint32_t> m_dirty;
+
+        /**
+         * @property If a slot is in the dirty list.
+         */
+        mutable std::vector<uint8_t> m_dirty_flags;
+
+        /**
+         * @property If the program holds the stored uniforms apart from the dirty ones, false after binding a snapshot.
+         */
+        mutable bool m_resident_stored = false;
+
+        /**
+         * @property Names of the active uniform blocks, indexed by block index.
+         */
+        std::vector<std::string> m_uniform_blocks;
+
+        /**
+         * @property Generation of the uniform block registry the blocks were last bound with, 0 if they never were.
+         */
+        mutable uint64_t m_block_generation = 0;
     };
 
 }
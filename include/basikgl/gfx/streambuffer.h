@@ -0,0 +1,202 @@
+/**
+ * @file gfx/streambuffer.h
+ * @brief Contains the persistently mapped ring buffer used for streaming vertex data.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <basikgl/core/core.h>
+#include <basikgl/gfx/asset.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /// @brief Forward declaration of AssetManager class.
+    class AssetManager;
+
+    /**
+     * @class StreamBuffer
+     * @brief Represents an immutable opengl buffer object which stays mapped for its whole lifetime.
+     * The buffer is split into regions used as a ring, every region is guarded by a fence when it's left,
+     * so writing to a region never stalls unless the GPU is still reading it.
+     * Writes are coherent, no flush is needed before drawing.
+     * This class follows RAII.
+     */
+    class BSK_API StreamBuffer final : public Asset {
+        friend AssetManager;
+    public:
+        /**
+         * @property Default number of regions, one for the frame being written and two for the frames the GPU may still be reading.
+         */
+        static constexpr uint32_t default_num_regions = 3;
+
+        /**
+         * @struct Allocation
+         * @brief Memory handed out by @fn StreamBuffer::allocate().
+         */
+        struct Allocation {
+            /**
+             * @property Mapped memory to write to, nullptr if the allocation failed.
+             */
+            void* data = nullptr;
+
+            /**
+             * @property Offset of the memory from the start of the buffer in bytes.
+             */
+            size_t offset = 0;
+        };
+
+    private:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] uuid UUID of this instance.
+         * @param[in] region_size Size of a region in bytes.
+         * @param[in] num_regions Number of regions.
+         */
+        StreamBuffer(UUID uuid, size_t region_size, uint32_t num_regions = default_num_regions);
+
+    public:
+        /**
+         * @brief Move Constructor
+         */
+        StreamBuffer(StreamBuffer&& other) noexcept;
+
+        /**
+         * @brief Move Assignment Operator
+         */
+        StreamBuffer& operator=(StreamBuffer&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         */
+        ~StreamBuffer();
+
+        StreamBuffer(const StreamBuffer& other) = delete;
+        StreamBuffer& operator=(const StreamBuffer& other) = delete;
+
+        /**
+         * @implements Asset::uuid()
+         */
+        [[nodiscard]]
+        UUID uuid() const override;
+
+        /**
+         * @brief Returns the OpenGL ID of the buffer.
+         *
+         * @retval uint32_t
+         * @returns OpenGL ID of the buffer.
+         */
+        [[nodiscard]]
+        uint32_t gl_id() const;
+
+        /**
+         * @retval size_t
+         * @returns Size of a region in bytes.
+         */
+        [[nodiscard]]
+        size_t region_size() const;
+
+        /**
+         * @retval uint32_t
+         * @returns Number of regions.
+         */
+        [[nodiscard]]
+        uint32_t num_regions() const;
+
+        /**
+         * @retval uint32_t
+         * @returns Index of the region being written.
+         */
+        [[nodiscard]]
+        uint32_t current_region() const;
+
+        /**
+         * @brief Hands out memory from the current region, moves to the next region if the current one is full.
+         *
+         * @param[in] size Size in bytes, at most the size of a region.
+         * @param[in] alignment Alignment of the offset from the start of the buffer.
+         *
+         * @retval Allocation
+         * @returns Mapped memory and its offset in the buffer.
+         */
+        Allocation allocate(size_t size, size_t alignment = 1);
+
+        /**
+         * @brief Fences the current region and moves to the next one, waits if the GPU is still reading it.
+         * Called once per frame, draws using the current region must have been issued already.
+         */
+        void next_region();
+
+        /**
+         * @brief Binds the stream buffer as the array buffer.
+         */
+        void bind() const;
+
+        /**
+         * @brief Unbinds the currently bound array buffer.
+         */
+        static void unbind();
+
+    private:
+        /**
+         * @brief Waits until the GPU is done reading a region, then deletes its fence.
+         *
+         * @param[in] region Index of the region.
+         */
+        void m_wait(uint32_t region);
+
+        /**
+         * @brief Unmaps and deletes the buffer and its fences.
+         */
+        void m_release();
+
+    private:
+        /**
+         * @property Unique Universal Identifier of this instance.
+         */
+        UUID m_uuid;
+
+        /**
+         * @property GPU side id of this instance.
+         */
+        uint32_t m_glid;
+
+        /**
+         * @property Size of a region in bytes.
+         */
+        size_t m_region_size;
+
+        /**
+         * @property Number of regions.
+         */
+        uint32_t m_num_regions;
+
+        /**
+         * @property Index of the region being written.
+         */
+        uint32_t m_region;
+
+        /**
+         * @property Bytes handed out from the current region.
+         */
+        size_t m_head;
+
+        /**
+         * @property Start of the mapped buffer.
+         */
+        uint8_t* m_mapped;
+
+        /**
+         * @property Fence of every region (GLsync, kept opaque so this header doesn't need OpenGL), nullptr if none.
+         */
+        std::vector<void*> m_fences;
+    };
+
+}
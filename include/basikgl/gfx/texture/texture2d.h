@@ -9,6 +9,7 @@
 #include <basikgl/core/core.h>
 #include <basikgl/sprite/sprite.h>
 #include <basikgl/gfx/texture/texture.h>
+#include <basikgl/gfx/residency.h>
 
 /**
  * @namespace bskgl
@@ -169,12 +170,35 @@ namespace bskgl {
         WrapMode wrap_mode_t() const override;
 
         /**
+         * @brief Returns the associated sprite.
+         * If the pixels were released, they're reloaded from the texture file or read back from the GPU first.
+         * The GPU copy is read back if the file is gone or its size changed since the upload.
+         * Reading back has to happen on the thread owning the context.
+         * 
          * @retval const Sprite& 
          * @returns The associated sprite.
          */
         [[nodiscard]]
         const Sprite& sprite() const;
 
+        /**
+         * @retval Residency
+         * @returns Residency policy of the texture.
+         */
+        [[nodiscard]]
+        Residency residency() const;
+
+        /**
+         * @brief Sets the residency policy of the texture.
+         * A GPU only texture releases the pixels of its sprite after every @fn Texture2D::sync(), the size is kept.
+         * 
+         * @param[in] residency Residency policy.
+         * 
+         * @retval Texture2D& 
+         * @returns Reference to the updated variable.
+         */
+        Texture2D& set_residency(Residency residency);
+
         /**
          * @brief Sets the minification filter.
          * 
@@ -246,6 +270,19 @@ namespace bskgl {
          */
         Texture2D& sync();
 
+    private:
+        /**
+         * @brief Releases the pixels of the sprite.
+         */
+        void m_release();
+
+        /**
+         * @brief Reloads the released pixels from the texture file, or reads them back if there is no file.
+         * A file that can't be loaded anymore or whose size changed since the upload is skipped, the pixels are read back then.
+         * Reading back is refused with an assertion on threads without a current context, the pixels stay released.
+         */
+        void m_restore() const;
+
     public:
         /**
          * @property The texture type (Texture2D).
@@ -271,7 +308,22 @@ namespace bskgl {
         /**
          * @property The sprite associated with the texture.
          */
-        Sprite m_sprite;
+        mutable Sprite m_sprite;
+
+        /**
+         * @property The file the texture was read from, empty if it was created from a sprite.
+         */
+        std::filesystem::path m_source;
+
+        /**
+         * @property Residency policy of the texture.
+         */
+        Residency m_residency = Residency::Shadowed;
+
+        /**
+         * @property Bookkeeping of the released pixels.
+         */
+        mutable ResidentCopy m_released;
 
         /**
          * @property The internal format of the texture.
@@ -283,6 +335,16 @@ namespace bskgl {
          */
         TextureBase::Format m_format;
 
+        /**
+         * @property Width of the immutable storage, zero before the first upload.
+         */
+        uint32_t m_storage_width = 0;
+
+        /**
+         * @property Height of the immutable storage, zero before the first upload.
+         */
+        uint32_t m_storage_height = 0;
+
         /**
          * @property The minification filter setting.
          */
@@ -0,0 +1,135 @@
+/**
+ * @file gfx/uniformbuffer.h
+ * @brief Contains the uniform buffer shared by the uniform blocks of every program.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <type_traits>
+
+#include <basikgl/core/core.h>
+#include <basikgl/gfx/asset.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /// @brief Forward declaration of AssetManager class.
+    class AssetManager;
+
+    /**
+     * @class UniformBuffer
+     * @brief Represents an immutable opengl buffer object backing a uniform block.
+     * The buffer is uploaded once and read by every program declaring the block, see @fn RenderContext::register_uniform_block().
+     * Its contents follow the std140 layout of the block.
+     * This class follows RAII.
+     */
+    class BSK_API UniformBuffer final : public Asset {
+        friend AssetManager;
+    private:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] uuid UUID of this instance.
+         * @param[in] size Size of the buffer in bytes.
+         */
+        UniformBuffer(UUID uuid, size_t size);
+
+    public:
+        /**
+         * @brief Move Constructor
+         */
+        UniformBuffer(UniformBuffer&& other) noexcept;
+
+        /**
+         * @brief Move Assignment Operator
+         */
+        UniformBuffer& operator=(UniformBuffer&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         */
+        ~UniformBuffer();
+
+        UniformBuffer(const UniformBuffer& other) = delete;
+        UniformBuffer& operator=(const UniformBuffer& other) = delete;
+
+        /**
+         * @implements Asset::uuid()
+         */
+        [[nodiscard]]
+        UUID uuid() const override;
+
+        /**
+         * @brief Returns the OpenGL ID of the buffer.
+         *
+         * @retval uint32_t
+         * @returns OpenGL ID of the buffer.
+         */
+        [[nodiscard]]
+        uint32_t gl_id() const;
+
+        /**
+         * @retval size_t
+         * @returns Size of the buffer in bytes.
+         */
+        [[nodiscard]]
+        size_t size() const;
+
+        /**
+         * @brief Uploads data to the buffer.
+         *
+         * @param[in] data Data laid out as the block.
+         * @param[in] size Size of the data in bytes.
+         * @param[in] offset Offset into the buffer in bytes.
+         */
+        void update(const void* data, size_t size, size_t offset = 0);
+
+        /**
+         * @brief Uploads a value to the buffer.
+         *
+         * @tparam T Type mirroring the std140 layout of the block or one of its members.
+         *
+         * @param[in] value Value to upload.
+         * @param[in] offset Offset into the buffer in bytes.
+         */
+        template <typename T>
+            requires (std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>)
+        void update(const T& value, size_t offset = 0) {
+            this->update(&value, sizeof(T), offset);
+        }
+
+        /**
+         * @brief Binds the whole buffer to a uniform buffer binding point.
+         *
+         * @param[in] binding Binding point.
+         */
+        void bind(uint32_t binding) const;
+
+    private:
+        /**
+         * @brief Deletes the buffer.
+         */
+        void m_release();
+
+    private:
+        /**
+         * @property Unique Universal Identifier of this instance.
+         */
+        UUID m_uuid;
+
+        /**
+         * @property GPU side id of this instance.
+         */
+        uint32_t m_glid;
+
+        /**
+         * @property Size of the buffer in bytes.
+         */
+        size_t m_size;
+    };
+
+}
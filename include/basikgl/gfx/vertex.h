@@ -10,6 +10,7 @@
 #include <glm/vec3.hpp>
 
 #include <basikgl/core/core.h>
+#include <basikgl/gfx/vertex_layout.h>
 
 /**
  * @namespace bskgl
@@ -22,6 +23,16 @@ namespace bskgl {
      * @brief Represents a bskgl vertex.
      */
     struct BSK_API Vertex final {
+        /**
+         * @typedef Format
+         * @brief Position at location 0, normal at location 1 and tex coords at location 2, 32 bytes.
+         */
+        using Format = VertexFormat<
+            Attribute<0, VertexAttributeType::Float, 3>,
+            Attribute<1, VertexAttributeType::Float, 3>,
+            Attribute<2, VertexAttributeType::Float, 2>
+        >;
+
         /**
          * @property Position of the vertex in 3-D space as a glm::vec3 ( @ref lib glm ).
          */
@@ -102,4 +113,54 @@ namespace bskgl {
         }
     };
 
-} 
\ No newline at end of file
+    /**
+     * @struct PositionVertex
+     * @brief Vertex with only a position, for depth only passes and untextured meshes.
+     */
+    struct BSK_API PositionVertex final {
+        /**
+         * @typedef Format
+         * @brief Position at location 0, 12 bytes.
+         */
+        using Format = VertexFormat<
+            Attribute<0, VertexAttributeType::Float, 3>
+        >;
+
+        /**
+         * @property Position of the vertex in 3-D space as a glm::vec3 ( @ref lib glm ).
+         */
+        glm::vec3 position = glm::vec3(0.0f);
+
+        bool operator==(const PositionVertex& other) const = default;
+    };
+
+    /**
+     * @struct SpriteVertex
+     * @brief Vertex with a position and tex coords, for sprites and other flat textured meshes.
+     */
+    struct BSK_API SpriteVertex final {
+        /**
+         * @typedef Format
+         * @brief Position at location 0 and tex coords at location 2, 20 bytes.
+         */
+        using Format = VertexFormat<
+            Attribute<0, VertexAttributeType::Float, 3>,
+            Attribute<2, VertexAttributeType::Float, 2>
+        >;
+
+        /**
+         * @property Position of the vertex in 3-D space as a glm::vec3 ( @ref lib glm ).
+         */
+        glm::vec3 position = glm::vec3(0.0f);
+
+        /**
+         * @property UV texel coordinates of the vertex as a glm::vec2 ( @ref lib glm ).
+         */
+        glm::vec2 tex_coords = glm::vec2(0.0f);
+
+        bool operator==(const SpriteVertex& other) const = default;
+    };
+
+    static_assert(VertexType<Vertex> && VertexType<PositionVertex> && VertexType<SpriteVertex>);
+
+}
\ No newline at end of file
@@ -0,0 +1,180 @@
+/**
+ * @file gfx/vertex_data.h
+ * @brief Contains the type erased CPU side storage of vertices.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <basikgl/core/core.h>
+#include <basikgl/core/error_handler.h>
+#include <basikgl/gfx/vertex_layout.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /**
+     * @class VertexData
+     * @brief Vertices of any @concept VertexType stored as bytes described by a @class VertexLayout.
+     * Typed vectors are adopted without copying, the vertices stay in the memory of the moved vector.
+     */
+    class BSK_API VertexData final {
+    public:
+        /**
+         * @brief Constructor
+         * Creates empty vertex data without attributes.
+         */
+        VertexData();
+
+        /**
+         * @brief Constructor
+         * Adopts a vector of typed vertices, the layout comes from the vertex format.
+         *
+         * @tparam V Vertex type.
+         *
+         * @param[in] vertices Vector of vertices, moved in.
+         */
+        template <VertexType V>
+        explicit VertexData(std::vector<V> vertices)
+            :
+            m_layout(V::Format::layout()) {
+            auto owner = std::make_shared<std::vector<V>>(std::move(vertices));
+            m_adopt(owner, reinterpret_cast<uint8_t*>(owner->data()), owner->size());
+        }
+
+        /**
+         * @brief Constructor
+         * Adopts raw vertices described by a runtime layout.
+         *
+         * @param[in] layout Layout of a vertex.
+         * @param[in] bytes Tightly packed vertices, the size must be a multiple of the stride.
+         */
+        VertexData(VertexLayout layout, std::vector<uint8_t> bytes);
+
+        /**
+         * @brief Move Constructor
+         */
+        VertexData(VertexData&& other) noexcept;
+
+        /**
+         * @brief Move Assignment Operator
+         */
+        VertexData& operator=(VertexData&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         */
+        ~VertexData() = default;
+
+        VertexData(const VertexData& other) = delete;
+        VertexData& operator=(const VertexData& other) = delete;
+
+        /**
+         * @retval const VertexLayout&
+         * @returns Layout of a vertex.
+         */
+        [[nodiscard]]
+        const VertexLayout& layout() const;
+
+        /**
+         * @retval size_t
+         * @returns Number of vertices, kept when the storage is released.
+         */
+        [[nodiscard]]
+        size_t size() const;
+
+        /**
+         * @retval size_t
+         * @returns Size of the vertices in bytes.
+         */
+        [[nodiscard]]
+        size_t size_bytes() const;
+
+        /**
+         * @retval uint8_t*
+         * @returns Start of the vertices, nullptr if released.
+         */
+        [[nodiscard]]
+        uint8_t* data();
+
+        /**
+         * @retval const uint8_t*
+         * @returns Start of the vertices, nullptr if released.
+         */
+        [[nodiscard]]
+        const uint8_t* data() const;
+
+        /**
+         * @brief Returns the vertices as the given type.
+         *
+         * @tparam V Vertex type, its format must match the layout.
+         *
+         * @retval std::span<const V>
+         * @returns Span over the vertices.
+         */
+        template <VertexType V>
+        [[nodiscard]]
+        std::span<const V> as() const {
+            BSK_VERIFY(V::Format::layout() == m_layout, "Vertex type doesn't match the layout of the vertex data.");
+            return std::span<const V>(reinterpret_cast<const V*>(m_data), m_data ? m_size : 0);
+        }
+
+        /**
+         * @brief Returns if the storage is held.
+         *
+         * @retval bool
+         * @returns False if the storage was released.
+         */
+        [[nodiscard]]
+        bool is_resident() const;
+
+        /**
+         * @brief Frees the storage, the layout and the number of vertices are kept.
+         */
+        void release();
+
+        /**
+         * @brief Allocates zeroed storage for the kept number of vertices, used to read released vertices back.
+         */
+        void reallocate();
+
+    private:
+        /**
+         * @brief Takes ownership of the memory holding the vertices.
+         *
+         * @param[in] owner Object keeping the memory alive.
+         * @param[in] data Start of the vertices.
+         * @param[in] size Number of vertices.
+         */
+        void m_adopt(std::shared_ptr<void> owner, uint8_t* data, size_t size);
+
+    private:
+        /**
+         * @property Layout of a vertex.
+         */
+        VertexLayout m_layout;
+
+        /**
+         * @property Object owning the memory of the vertices.
+         */
+        std::shared_ptr<void> m_owner;
+
+        /**
+         * @property Start of the vertices.
+         */
+        uint8_t* m_data = nullptr;
+
+        /**
+         * @property Number of vertices.
+         */
+        size_t m_size = 0;
+    };
+
+}
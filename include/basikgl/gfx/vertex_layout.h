@@ -0,0 +1,271 @@
+/**
+ * @file gfx/vertex_layout.h
+ * @brief Contains the vertex layout descriptor and the compile time vertex formats building it.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <type_traits>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include <basikgl/core/core.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /**
+     * @enum VertexAttributeType
+     * @brief Component type of a vertex attribute.
+     */
+    enum class VertexAttributeType : uint8_t {
+        Float,
+        HalfFloat,
+        Byte,
+        UnsignedByte,
+        Short,
+        UnsignedShort,
+        Int,
+        UnsignedInt
+    };
+
+    /**
+     * @brief Returns the size of a single component of the given type.
+     *
+     * @param[in] type Component type.
+     *
+     * @retval uint32_t
+     * @returns Size in bytes.
+     */
+    [[nodiscard]]
+    constexpr uint32_t vertex_attribute_type_size(VertexAttributeType type) {
+        switch (type) {
+            case VertexAttributeType::Byte:
+            case VertexAttributeType::UnsignedByte:
+                return 1;
+            case VertexAttributeType::HalfFloat:
+            case VertexAttributeType::Short:
+            case VertexAttributeType::UnsignedShort:
+                return 2;
+            default:
+                return 4;
+        }
+    }
+
+    /**
+     * @brief Checks if the given type has integer components.
+     *
+     * @param[in] type Component type.
+     *
+     * @retval bool
+     * @returns True for every type but Float and HalfFloat.
+     */
+    [[nodiscard]]
+    constexpr bool vertex_attribute_type_is_integer(VertexAttributeType type) {
+        return type != VertexAttributeType::Float && type != VertexAttributeType::HalfFloat;
+    }
+
+    /**
+     * @struct VertexAttribute
+     * @brief Describes where and how one attribute is stored in a vertex.
+     */
+    struct VertexAttribute {
+        /**
+         * @property Shader location of the attribute.
+         */
+        uint32_t location = 0;
+
+        /**
+         * @property Number of components, 1 to 4.
+         */
+        uint32_t components = 0;
+
+        /**
+         * @property Type of the components.
+         */
+        VertexAttributeType type = VertexAttributeType::Float;
+
+        /**
+         * @property If integer components are mapped to [0, 1] or [-1, 1].
+         */
+        bool normalized = false;
+
+        /**
+         * @property Offset of the attribute from the start of the vertex in bytes.
+         */
+        uint32_t offset = 0;
+
+        /**
+         * @property If integer components reach the shader as integers (ivec, uvec inputs) instead of being converted to float.
+         * Ignored for float types and normalized attributes.
+         */
+        bool integer = false;
+
+        bool operator==(const VertexAttribute& other) const = default;
+    };
+
+    /**
+     * @class VertexLayout
+     * @brief Runtime descriptor of the attributes of a vertex, usually built from a @struct VertexFormat.
+     */
+    class BSK_API VertexLayout final {
+    public:
+        /**
+         * @brief Constructor
+         * Creates a layout without attributes.
+         */
+        VertexLayout();
+
+        /**
+         * @brief Constructor
+         *
+         * @param[in] attributes Attributes of the vertex.
+         * @param[in] stride Size of a vertex in bytes.
+         */
+        VertexLayout(std::vector<VertexAttribute> attributes, uint32_t stride);
+
+        /**
+         * @retval const std::vector<VertexAttribute>&
+         * @returns Attributes of the vertex.
+         */
+        [[nodiscard]]
+        const std::vector<VertexAttribute>& attributes() const;
+
+        /**
+         * @retval uint32_t
+         * @returns Size of a vertex in bytes.
+         */
+        [[nodiscard]]
+        uint32_t stride() const;
+
+        /**
+         * @brief Returns the attribute bound to a shader location.
+         *
+         * @param[in] location Shader location.
+         *
+         * @retval const VertexAttribute*
+         * @returns Attribute at the location, nullptr if there is none.
+         */
+        [[nodiscard]]
+        const VertexAttribute* find(uint32_t location) const;
+
+        /**
+         * @brief Decodes the position, the attribute at location 0, of a vertex.
+         *
+         * @param[in] vertex Start of the vertex.
+         *
+         * @retval glm::vec3
+         * @returns Position of the vertex, origin if the layout has no position.
+         */
+        [[nodiscard]]
+        glm::vec3 position(const uint8_t* vertex) const;
+
+        /**
+         * @brief Enables the vertex attributes of a vertex array and sources them from one of its buffer binding points.
+         * Only the attribute formats are set, the buffer and the stride are attached with glVertexArrayVertexBuffer.
+         *
+         * @param[in] vertexarray OpenGL ID of the vertex array, it doesn't have to be bound.
+         * @param[in] binding Buffer binding point of the vertex array.
+         */
+        void apply(uint32_t vertexarray, uint32_t binding = 0) const;
+
+        /**
+         * @brief Disables the vertex attributes of a vertex array.
+         *
+         * @param[in] vertexarray OpenGL ID of the vertex array, it doesn't have to be bound.
+         */
+        void disable(uint32_t vertexarray) const;
+
+        bool operator==(const VertexLayout& other) const = default;
+
+    private:
+        /**
+         * @property Attributes of the vertex.
+         */
+        std::vector<VertexAttribute> m_attributes;
+
+        /**
+         * @property Size of a vertex in bytes.
+         */
+        uint32_t m_stride;
+    };
+
+    /**
+     * @struct Attribute
+     * @brief Compile time description of a vertex attribute.
+     *
+     * @tparam Location Shader location.
+     * @tparam Type Component type.
+     * @tparam Components Number of components.
+     * @tparam Normalized If integer components are normalized.
+     * @tparam Integer If integer components reach the shader as integers instead of being converted to float.
+     */
+    template <uint32_t Location, VertexAttributeType Type, uint32_t Components, bool Normalized = false, bool Integer = false>
+    struct Attribute {
+        static_assert(Components >= 1 && Components <= 4, "Vertex attributes have one to four components.");
+        static_assert(!Integer || (vertex_attribute_type_is_integer(Type) && !Normalized), "Integer attributes need a non normalized integer type.");
+
+        static constexpr uint32_t location = Location;
+        static constexpr VertexAttributeType type = Type;
+        static constexpr uint32_t components = Components;
+        static constexpr bool normalized = Normalized;
+        static constexpr bool integer = Integer;
+        static constexpr uint32_t size = Components * vertex_attribute_type_size(Type);
+    };
+
+    /**
+     * @struct VertexFormat
+     * @brief Compile time vertex format, attributes are packed in order without padding.
+     *
+     * @tparam ...Attrs @struct Attribute of every attribute in the vertex.
+     */
+    template <typename... Attrs>
+    struct VertexFormat {
+        /**
+         * @property Size of a vertex in bytes.
+         */
+        static constexpr uint32_t stride = (0 + ... + Attrs::size);
+
+        /**
+         * @property Attributes with their offsets, computed at compile time.
+         */
+        static constexpr std::array<VertexAttribute, sizeof...(Attrs)> attributes = []() {
+            std::array<VertexAttribute, sizeof...(Attrs)> result = {};
+            uint32_t offset = 0;
+            size_t index = 0;
+
+            ((result[index++] = { Attrs::location, Attrs::components, Attrs::type, Attrs::normalized, offset, Attrs::integer }, offset += Attrs::size), ...);
+
+            return result;
+        }();
+
+        /**
+         * @brief Builds the runtime descriptor of the format.
+         *
+         * @retval VertexLayout
+         * @returns Layout of the format.
+         */
+        [[nodiscard]]
+        static VertexLayout layout() {
+            return VertexLayout(std::vector<VertexAttribute>(attributes.begin(), attributes.end()), stride);
+        }
+    };
+
+    /**
+     * @concept VertexType
+     * @brief A vertex struct declaring its @struct VertexFormat as Format, its size must match the packed format.
+     */
+    template <typename V>
+    concept VertexType = std::is_trivially_copyable_v<V> && requires {
+        { V::Format::stride } -> std::convertible_to<uint32_t>;
+        { V::Format::layout() } -> std::same_as<VertexLayout>;
+    } && sizeof(V) == V::Format::stride;
+
+}
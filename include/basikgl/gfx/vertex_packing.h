@@ -0,0 +1,176 @@
+/**
+ * @file gfx/vertex_packing.h
+ * @brief Contains the quantized vertex format and the encoders converting full precision vertices into it.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <basikgl/core/core.h>
+#include <basikgl/gfx/bounds.h>
+#include <basikgl/gfx/vertex.h>
+#include <basikgl/gfx/vertex_layout.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /**
+     * @struct PackedVertex
+     * @brief Quantized @struct Vertex, 16 bytes instead of 32.
+     * Positions are snorm16 relative to the mesh bounds, normals are octahedral encoded snorm16 and tex coords are half floats.
+     * The shader receives the position in [-1, 1] and has to apply @fn Quantization::matrix(), usually folded into the model matrix,
+     * the normal arrives as a vec2 and is decoded with @property PackedVertex::glsl_decode_normal.
+     */
+    struct BSK_API PackedVertex final {
+        /**
+         * @typedef Format
+         * @brief Position at location 0, octahedral normal at location 1 and tex coords at location 2, 16 bytes.
+         */
+        using Format = VertexFormat<
+            Attribute<0, VertexAttributeType::Short, 4, true>,
+            Attribute<1, VertexAttributeType::Short, 2, true>,
+            Attribute<2, VertexAttributeType::HalfFloat, 2>
+        >;
+
+        /**
+         * @property GLSL function decoding the octahedral normal, paste it into the vertex shader before main.
+         */
+        static constexpr const char* glsl_decode_normal =
+            "vec3 bsk_decode_normal(vec2 e) {\n"
+            "    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));\n"
+            "    float t = max(-n.z, 0.0);\n"
+            "    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);\n"
+            "    return normalize(n);\n"
+            "}\n";
+
+        /**
+         * @property Quantized position, the fourth component is always one so the shader can read it as a vec4.
+         */
+        int16_t position[4] = { 0, 0, 0, 0 };
+
+        /**
+         * @property Octahedral encoded normal.
+         */
+        int16_t normal[2] = { 0, 0 };
+
+        /**
+         * @property Tex coords as half floats.
+         */
+        uint16_t tex_coords[2] = { 0, 0 };
+
+        bool operator==(const PackedVertex& other) const = default;
+    };
+
+    static_assert(VertexType<PackedVertex>);
+
+    /**
+     * @struct Quantization
+     * @brief Maps quantized positions in [-1, 1] back to model space, position = offset + scale * quantized.
+     */
+    struct BSK_API Quantization final {
+        /**
+         * @property Center of the quantized volume.
+         */
+        glm::vec3 offset = glm::vec3(0.0f);
+
+        /**
+         * @property Half extent of the quantized volume on each axis.
+         */
+        glm::vec3 scale = glm::vec3(1.0f);
+
+        /**
+         * @brief Creates the quantization covering the given bounds.
+         *
+         * @param[in] bounds Bounds of the mesh.
+         *
+         * @retval Quantization
+         * @returns Quantization with the bounds mapped to [-1, 1], flat axes keep a scale of one.
+         */
+        [[nodiscard]]
+        static Quantization from_bounds(const Bounds& bounds);
+
+        /**
+         * @brief Returns the dequantization as a matrix, multiply the model matrix by it so the shader needs no extra uniform.
+         *
+         * @retval glm::mat4
+         * @returns Translation by the offset times scale.
+         */
+        [[nodiscard]]
+        glm::mat4 matrix() const;
+
+        bool operator==(const Quantization& other) const = default;
+    };
+
+    /**
+     * @class VertexPacker
+     * @brief Converts @struct Vertex data into @struct PackedVertex and back.
+     * Uses SSE2, and F16C for the tex coords, when the compiler targets them, otherwise scalar code with identical results.
+     */
+    class BSK_API VertexPacker final {
+    public:
+        VertexPacker() = delete;
+
+        /**
+         * @brief Returns the quantization covering all the given vertices.
+         *
+         * @param[in] vertices Vertices to be packed.
+         *
+         * @retval Quantization
+         * @returns Quantization of the bounds of the vertices.
+         */
+        [[nodiscard]]
+        static Quantization quantization(std::span<const Vertex> vertices);
+
+        /**
+         * @brief Packs the vertices.
+         *
+         * @param[in] vertices Vertices to be packed.
+         * @param[in] quantization Quantization of the positions, usually @fn VertexPacker::quantization() of the same vertices, positions outside of it are clamped.
+         *
+         * @retval std::vector<PackedVertex>
+         * @returns Packed vertices in the same order.
+         */
+        [[nodiscard]]
+        static std::vector<PackedVertex> pack(std::span<const Vertex> vertices, const Quantization& quantization);
+
+        /**
+         * @brief Decodes a packed vertex, the inverse of the packing up to its precision.
+         *
+         * @param[in] vertex Packed vertex.
+         * @param[in] quantization Quantization the vertex was packed with.
+         *
+         * @retval Vertex
+         * @returns Decoded vertex.
+         */
+        [[nodiscard]]
+        static Vertex unpack(const PackedVertex& vertex, const Quantization& quantization);
+
+        /**
+         * @brief Encodes a unit vector with the octahedral mapping.
+         *
+         * @param[in] normal Unit vector, a zero vector encodes to +z.
+         * @param[out] encoded Two snorm16 components.
+         */
+        static void encode_octahedral(const glm::vec3& normal, int16_t encoded[2]);
+
+        /**
+         * @brief Decodes an octahedral encoded unit vector.
+         *
+         * @param[in] encoded Two snorm16 components.
+         *
+         * @retval glm::vec3
+         * @returns Normalized vector.
+         */
+        [[nodiscard]]
+        static glm::vec3 decode_octahedral(const int16_t encoded[2]);
+    };
+
+}
@@ -0,0 +1,76 @@
+/**
+ * @file gfx/vertex_welder.h
+ * @brief Contains the welding of duplicate vertices into an indexed mesh.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <basikgl/core/core.h>
+#include <basikgl/gfx/vertex_data.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /**
+     * @class VertexWelder
+     * @brief Merges equal vertices through hashing, turning unindexed triangle soup into vertices plus indices.
+     * Vertices are compared attribute by attribute through their layout, the first occurrence of every vertex is kept
+     * and the output order follows the input, so the result doesn't depend on the number of threads.
+     * Large inputs are hashed and deduplicated on several threads.
+     */
+    class BSK_API VertexWelder final {
+    public:
+        /**
+         * @property Number of vertices from which the work is split across threads.
+         */
+        static constexpr size_t parallel_threshold = 1 << 16;
+
+    public:
+        VertexWelder() = delete;
+
+        /**
+         * @brief Welds unindexed vertices.
+         *
+         * @param[in, out] vertices Vertices, every three form a triangle, replaced by the unique vertices.
+         * @param[in] epsilon Zero compares the attributes bit for bit, otherwise float components are snapped to a grid of this size before comparing.
+         *
+         * @retval std::vector<uint32_t>
+         * @returns Indices drawing the same triangles from the unique vertices.
+         */
+        [[nodiscard]]
+        static std::vector<uint32_t> weld(VertexData& vertices, float epsilon = 0.0f);
+
+        /**
+         * @brief Welds the vertices of an indexed mesh.
+         *
+         * @param[in, out] vertices Vertices, replaced by the unique vertices.
+         * @param[in] indices Triangle list of the mesh.
+         * @param[in] epsilon Zero compares the attributes bit for bit, otherwise float components are snapped to a grid of this size before comparing.
+         *
+         * @retval std::vector<uint32_t>
+         * @returns Indices drawing the same triangles from the unique vertices, the input indices if any is out of range.
+         */
+        [[nodiscard]]
+        static std::vector<uint32_t> weld(VertexData& vertices, std::span<const uint32_t> indices, float epsilon = 0.0f);
+
+        /**
+         * @brief Finds the unique vertices without modifying them.
+         *
+         * @param[in] vertices Vertices to compare.
+         * @param[out] remap For every vertex, the index it has among the unique vertices.
+         * @param[in] epsilon Zero compares the attributes bit for bit, otherwise float components are snapped to a grid of this size before comparing.
+         *
+         * @retval size_t
+         * @returns Number of unique vertices.
+         */
+        static size_t generate_remap(const VertexData& vertices, std::vector<uint32_t>& remap, float epsilon = 0.0f);
+    };
+
+}
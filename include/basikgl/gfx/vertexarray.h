@@ -7,11 +7,16 @@
 #pragma once
 
 #include <memory>
+#include <span>
+#include <vector>
 
 #include <basikgl/core/core.h>
 #include <basikgl/gfx/asset.h>
 #include <basikgl/gfx/vertexbuffer.h>
 #include <basikgl/gfx/indexbuffer.h>
+#include <basikgl/gfx/instancebuffer.h>
+#include <basikgl/gfx/streambuffer.h>
+#include <basikgl/gfx/lod.h>
 
 /**
  * @namespace bskgl
@@ -74,13 +79,36 @@ namespace bskgl {
         uint32_t gl_id() const;
 
         /**
-         * @brief Returns vector of vertices.
+         * @brief Returns the vertices as the given type.
          * 
-         * @retval const std::vector<Vertex>&
-         * @returns Vector of vertices.
+         * @tparam V Vertex type, its format must match the layout of the vertex buffer.
+         * 
+         * @retval std::span<const V>
+         * @returns Span over the vertices.
+         */
+        template <VertexType V = Vertex>
+        [[nodiscard]]
+        std::span<const V> vertices() const {
+            return m_vbuffer->vertices<V>();
+        }
+
+        /**
+         * @brief Returns the vertices without a type, for code that works with any layout.
+         * 
+         * @retval const VertexData&
+         * @returns Vertices and their layout.
+         */
+        [[nodiscard]]
+        const VertexData& vertex_data() const;
+
+        /**
+         * @brief Returns the layout of the vertices.
+         * 
+         * @retval const VertexLayout&
+         * @returns Layout of a vertex.
          */
         [[nodiscard]]
-        const std::vector<Vertex>& vertices() const;
+        const VertexLayout& layout() const;
 
         /**
          * @brief Returns vector of indices.
@@ -109,6 +137,24 @@ namespace bskgl {
         [[nodiscard]]
         size_t num_indices() const;
 
+        /**
+         * @brief Returns the type of the indices in the GPU side index buffer.
+         * 
+         * @retval IndexType
+         * @returns Type to pass to the draw calls, 32 bit if there is no index buffer.
+         */
+        [[nodiscard]]
+        IndexType index_type() const;
+
+        /**
+         * @brief Returns the bounds of the vertex buffer, in the local space of the mesh.
+         * 
+         * @retval const Bounds&
+         * @returns Bounding box and sphere of the vertices.
+         */
+        [[nodiscard]]
+        const Bounds& bounds() const;
+
         /**
          * @brief Returns uuid vertex buffer associated in the array.
          * 
@@ -128,18 +174,33 @@ namespace bskgl {
         UUID ibuffer() const;
 
         /**
-         * @brief Sets the vertices.
+         * @brief Sets the vertices, the attributes follow their layout after the next @fn VertexArray::sync().
          * Setting the vertices does not update the buffer stored in the GPU, call @fn VertexArray::sync() to update the GPU side array.
          * 
-         * @param[in] vertices Vector of vertices.
+         * @param[in] vertices Vertices and their layout, moved into the vertex buffer.
          * 
          * @retval VertexArray&
          * @returns Reference to the updated variable.
          */
-        VertexArray& set_vertices(const std::vector<Vertex>& vertices);
+        VertexArray& set_vertices(VertexData vertices);
 
         /**
-         * @brief Sets the indices.
+         * @brief Sets the vertices, the attributes follow their layout after the next @fn VertexArray::sync().
+         * 
+         * @tparam V Vertex type.
+         * 
+         * @param[in] vertices Vector of vertices, moved into the vertex buffer.
+         * 
+         * @retval VertexArray&
+         * @returns Reference to the updated variable.
+         */
+        template <VertexType V>
+        VertexArray& set_vertices(std::vector<V> vertices) {
+            return this->set_vertices(VertexData(std::move(vertices)));
+        }
+
+        /**
+         * @brief Sets the indices, the levels of detail are cleared.
          * Setting the indices does not update the buffer stored in the GPU, call @fn VertexArray::sync() to update the GPU side array.
          * 
          * @param[in] indices Vector of indices.
@@ -150,13 +211,138 @@ namespace bskgl {
         VertexArray& set_indices(const std::vector<uint32_t>& indices);
 
         /**
-         * @brief Binds the vertex buffer.
+         * @brief Sets the indices, moving them into the index buffer, the levels of detail are cleared.
+         * 
+         * @param[in] indices Vector of indices.
+         * 
+         * @retval VertexArray&
+         * @returns Reference to the updated variable.
+         */
+        VertexArray& set_indices(std::vector<uint32_t>&& indices);
+
+        /**
+         * @brief Overwrites a range of vertices, only the range is uploaded on the next @fn VertexArray::sync().
+         * 
+         * @tparam V Vertex type, its format must match the layout of the vertex buffer.
+         * 
+         * @param[in] offset Index of the first vertex to overwrite.
+         * @param[in] vertices Vertices to write.
+         * 
+         * @retval VertexArray&
+         * @returns Reference to the updated variable.
+         */
+        template <VertexType V>
+        VertexArray& update_vertices(size_t offset, std::span<const V> vertices) {
+            m_vbuffer->update_vertices(offset, vertices);
+            return *this;
+        }
+
+        /**
+         * @brief Overwrites a range of vertices, only the range is uploaded on the next @fn VertexArray::sync().
+         * 
+         * @tparam V Vertex type, its format must match the layout of the vertex buffer.
+         * 
+         * @param[in] offset Index of the first vertex to overwrite.
+         * @param[in] vertices Vertices to write.
+         * 
+         * @retval VertexArray&
+         * @returns Reference to the updated variable.
+         */
+        template <VertexType V>
+        VertexArray& update_vertices(size_t offset, const std::vector<V>& vertices) {
+            m_vbuffer->update_vertices(offset, vertices);
+            return *this;
+        }
+
+        /**
+         * @brief Overwrites a range of indices, only the range is uploaded on the next @fn VertexArray::sync().
+         * 
+         * @param[in] offset Position of the first index to overwrite.
+         * @param[in] indices Indices to write.
+         * 
+         * @retval VertexArray&
+         * @returns Reference to the updated variable.
+         */
+        VertexArray& update_indices(size_t offset, std::span<const uint32_t> indices);
+
+        /**
+         * @brief Sets the residency policy of the vertex and index buffers.
+         * 
+         * @param[in] residency Residency policy.
+         * 
+         * @retval VertexArray&
+         * @returns Reference to the updated variable.
+         */
+        VertexArray& set_residency(Residency residency);
+
+        /**
+         * @brief Replaces the indices with a chain of levels of detail, stored one after another in the index buffer.
+         * Call @fn VertexArray::sync() to update the GPU side array.
+         * 
+         * @param[in] levels Triangle lists from the full mesh to the coarsest one.
+         * @param[in] errors Object space error of every level, non decreasing, the full mesh usually has 0.
+         * 
+         * @retval VertexArray&
+         * @returns Reference to the updated variable.
+         */
+        VertexArray& set_lods(const std::vector<std::vector<uint32_t>>& levels, const std::vector<float>& errors);
+
+        /**
+         * @brief Sets the levels of detail as ranges of the current indices.
+         * 
+         * @param[in] lods Levels from the full mesh to the coarsest one, with non decreasing errors.
+         * 
+         * @retval VertexArray&
+         * @returns Reference to the updated variable.
+         */
+        VertexArray& set_lods(std::vector<LodLevel> lods);
+
+        /**
+         * @retval const std::vector<LodLevel>&
+         * @returns Levels of detail, empty if the whole index buffer is always drawn.
+         */
+        [[nodiscard]]
+        const std::vector<LodLevel>& lods() const;
+
+        /**
+         * @brief Attaches an instance buffer, its attributes advance once per instance.
+         * The attribute locations of the instance buffer must not overlap with the vertex attributes.
+         * 
+         * @param[in] ibuffer Shared ptr of the instance buffer.
+         * 
+         * @retval VertexArray&
+         * @returns Reference to the updated variable.
+         */
+        VertexArray& attach_instance_buffer(std::shared_ptr<InstanceBuffer> ibuffer);
+
+        /**
+         * @brief Returns uuid of the instance buffer attached to the array.
+         * 
+         * @retval UUID
+         * @returns Instance buffer, BSK_INVALID_UUID if none is attached.
+         */
+        [[nodiscard]]
+        UUID instance_buffer() const;
+
+        /**
+         * @brief Sources the vertex attributes from a stream buffer instead of the vertex buffer.
+         * Vertices are read starting at the base vertex of the draw, @fn VertexArray::sync() points the attributes back to the vertex buffer.
+         * 
+         * @param[in] stream Shared ptr of the stream buffer holding tightly packed vertices.
+         * 
+         * @retval VertexArray&
+         * @returns Reference to the updated variable.
+         */
+        VertexArray& attach_vertex_stream(std::shared_ptr<StreamBuffer> stream);
+
+        /**
+         * @brief Binds the vertex array, its buffers are attached to it.
          */
         void bind() const;
         
         /**
          * @brief Updates the GPU side array.
-         * This function binds the array, updates the array and then unbinds the array.
+         * The buffers are uploaded and attached through direct state access, no bindings change.
          * 
          * @retval VertexArray&
          * @returns Reference to the updated variable.
@@ -174,6 +360,13 @@ namespace bskgl {
          */
         static void unbind();
 
+    private:
+        /**
+         * @brief Sets the formats of the vertex attributes using the layout of the vertex buffer.
+         * Attributes of the previously applied layout missing from the new one are disabled.
+         */
+        void m_set_vertex_attributes();
+
     private:
         /**
          * @property Unique Universal Identifier of this instance.
@@ -194,6 +387,26 @@ namespace bskgl {
          * @property Index buffer associated with the array.
          */
         std::shared_ptr<IndexBuffer> m_ibuffer;
+
+        /**
+         * @property Instance buffer attached to the array.
+         */
+        std::shared_ptr<InstanceBuffer> m_instance_buffer;
+
+        /**
+         * @property Stream buffer the vertex attributes are sourced from, nullptr if the vertex buffer is used.
+         */
+        std::shared_ptr<StreamBuffer> m_vertex_stream;
+
+        /**
+         * @property Layout the vertex attributes were last set up with.
+         */
+        VertexLayout m_layout;
+
+        /**
+         * @property Levels of detail, ranges of the index buffer.
+         */
+        std::vector<LodLevel> m_lods;
     };
 
 }
\ No newline at end of file
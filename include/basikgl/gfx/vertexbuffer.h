@@ -7,9 +7,15 @@
 #pragma once
 
 #include <vector>
+#include <span>
 
 #include <basikgl/core/core.h>
 #include <basikgl/gfx/vertex.h>
+#include <basikgl/gfx/vertex_data.h>
+#include <basikgl/gfx/bounds.h>
+#include <basikgl/gfx/dirty_ranges.h>
+#include <basikgl/gfx/buffer_storage.h>
+#include <basikgl/gfx/residency.h>
 #include <basikgl/gfx/asset.h>
 
 /**
@@ -33,17 +39,33 @@ namespace bskgl {
          * @brief Constructor
          * 
          * @param[in] uuid UUID of this instance.
-         * @param[in] num_vertices Number of vertices.
+         * @param[in] num_vertices Number of default constructed @struct Vertex.
+         * @param[in] usage Usage class of the GPU side buffer.
          */
-        VertexBuffer(UUID uuid, size_t num_vertices);
+        VertexBuffer(UUID uuid, size_t num_vertices, BufferUsage usage = BufferUsage::Dynamic);
 
         /**
          * @brief Constructor
          * 
          * @param[in] uuid UUID of this instance.
-         * @param[in] vertices Vector of vertices.
+         * @param[in] vertices Vertices and their layout, moved into the buffer.
+         * @param[in] usage Usage class of the GPU side buffer.
          */
-        VertexBuffer(UUID uuid, const std::vector<Vertex>& vertices);
+        VertexBuffer(UUID uuid, VertexData vertices, BufferUsage usage = BufferUsage::Dynamic);
+
+        /**
+         * @brief Constructor
+         * 
+         * @tparam V Vertex type, its format becomes the layout of the buffer.
+         * 
+         * @param[in] uuid UUID of this instance.
+         * @param[in] vertices Vector of vertices, moved into the buffer.
+         * @param[in] usage Usage class of the GPU side buffer.
+         */
+        template <VertexType V>
+        VertexBuffer(UUID uuid, std::vector<V> vertices, BufferUsage usage = BufferUsage::Dynamic)
+            :
+            VertexBuffer(uuid, VertexData(std::move(vertices)), usage) { }
 
     public:
         /**
@@ -80,13 +102,68 @@ namespace bskgl {
         uint32_t gl_id() const;
 
         /**
-         * @brief Returns vector of vertices.
+         * @brief Returns the usage class of the buffer.
+         * 
+         * @retval BufferUsage
+         * @returns Usage class the GPU side buffer was created with.
+         */
+        [[nodiscard]]
+        BufferUsage usage() const;
+
+        /**
+         * @brief Returns the residency policy of the buffer.
+         * 
+         * @retval Residency
+         * @returns Residency policy of the buffer.
+         */
+        [[nodiscard]]
+        Residency residency() const;
+
+        /**
+         * @brief Sets the residency policy of the buffer.
+         * A GPU only buffer releases its CPU side copy after every @fn VertexBuffer::sync(), the copy is released right away if it's already uploaded.
+         * 
+         * @param[in] residency Residency policy.
+         * 
+         * @retval VertexBuffer&
+         * @returns Reference to the updated variable.
+         */
+        VertexBuffer& set_residency(Residency residency);
+
+        /**
+         * @brief Returns the layout of the vertices.
+         * 
+         * @retval const VertexLayout&
+         * @returns Layout of a vertex.
+         */
+        [[nodiscard]]
+        const VertexLayout& layout() const;
+
+        /**
+         * @brief Returns the vertices as the given type.
+         * If the CPU side copy was released, it's read back from the GPU first, which has to happen on the thread owning the context.
          * 
-         * @retval const std::vector<Vertex>&
-         * @returns Vector of vertices.
+         * @tparam V Vertex type, its format must match the layout of the buffer.
+         * 
+         * @retval std::span<const V>
+         * @returns Span over the vertices.
          */
+        template <VertexType V = Vertex>
         [[nodiscard]] 
-        const std::vector<Vertex>& vertices() const;
+        std::span<const V> vertices() const {
+            m_restore();
+            return m_vertices.as<V>();
+        }
+
+        /**
+         * @brief Returns the vertices without a type, for code that works with any layout.
+         * If the CPU side copy was released, it's read back from the GPU first, which has to happen on the thread owning the context.
+         * 
+         * @retval const VertexData&
+         * @returns Vertices and their layout.
+         */
+        [[nodiscard]]
+        const VertexData& vertex_data() const;
 
         /**
          * @brief Returns number of vertices.
@@ -98,15 +175,75 @@ namespace bskgl {
         size_t num_vertices() const;
 
         /**
-         * @brief Sets the vertices.
+         * @brief Returns the bounds of the vertices, computed on the last @fn VertexBuffer::sync().
+         * Partial updates only grow the bounds, they're recomputed exactly when the whole buffer is uploaded.
+         * 
+         * @retval const Bounds&
+         * @returns Bounding box and sphere of the vertex positions.
+         */
+        [[nodiscard]]
+        const Bounds& bounds() const;
+
+        /**
+         * @brief Sets the vertices, the layout of the buffer changes with them.
+         * Setting the vertices does not update the buffer stored in the GPU, call @fn VertexBuffer::sync() to update the GPU side buffer.
+         * 
+         * @param[in] vertices Vertices and their layout, moved into the buffer.
+         * 
+         * @retval VertexBuffer&
+         * @returns Reference to the updated variable.
+         */
+        VertexBuffer& set_vertices(VertexData vertices);
+
+        /**
+         * @brief Sets the vertices, the layout of the buffer changes with them.
          * Setting the vertices does not update the buffer stored in the GPU, call @fn VertexBuffer::sync() to update the GPU side buffer.
          * 
-         * @param[in] vertices Vector of vertices.
+         * @tparam V Vertex type.
+         * 
+         * @param[in] vertices Vector of vertices, moved into the buffer.
+         * 
+         * @retval VertexBuffer&
+         * @returns Reference to the updated variable.
+         */
+        template <VertexType V>
+        VertexBuffer& set_vertices(std::vector<V> vertices) {
+            return this->set_vertices(VertexData(std::move(vertices)));
+        }
+
+        /**
+         * @brief Overwrites a range of vertices.
+         * Only the modified range is uploaded on the next @fn VertexBuffer::sync(), nearby ranges are merged into one upload.
+         * 
+         * @tparam V Vertex type, its format must match the layout of the buffer.
+         * 
+         * @param[in] offset Index of the first vertex to overwrite.
+         * @param[in] vertices Vertices to write, the range must lie within the buffer.
          * 
          * @retval VertexBuffer&
          * @returns Reference to the updated variable.
          */
-        VertexBuffer& set_vertices(const std::vector<Vertex>& vertices);
+        template <VertexType V>
+        VertexBuffer& update_vertices(size_t offset, std::span<const V> vertices) {
+            BSK_VERIFY(V::Format::layout() == m_vertices.layout(), "Vertex type doesn't match the layout of the vertex buffer.");
+            return this->m_update(offset, reinterpret_cast<const uint8_t*>(vertices.data()), vertices.size());
+        }
+
+        /**
+         * @brief Overwrites a range of vertices.
+         * 
+         * @tparam V Vertex type, its format must match the layout of the buffer.
+         * 
+         * @param[in] offset Index of the first vertex to overwrite.
+         * @param[in] vertices Vertices to write, the range must lie within the buffer.
+         * 
+         * @retval VertexBuffer&
+         * @returns Reference to the updated variable.
+         */
+        template <VertexType V>
+        VertexBuffer& update_vertices(size_t offset, const std::vector<V>& vertices) {
+            return this->update_vertices(offset, std::span<const V>(vertices));
+        }
 
         /**
          * @brief Binds the vertex buffer.
@@ -115,7 +252,9 @@ namespace bskgl {
 
         /**
          * @brief Updates the GPU side buffer.
-         * This function binds the buffer, updates the buffer and then unbinds the buffer.
+         * The buffer is updated by name through direct state access, nothing is bound, so the bindings of the bound vertex array are left untouched.
+         * The buffer is reallocated and the bounds recomputed if the vertices were replaced or resized, otherwise only the dirty ranges are uploaded.
+         * Resizing a static buffer replaces the buffer object, sync the vertex array using it to reattach it.
          * 
          * @retval VertexBuffer&
          * @returns Reference to the updated variable.
@@ -127,6 +266,30 @@ namespace bskgl {
          */
         static void unbind();
 
+    private:
+        /**
+         * @brief Overwrites a range of vertices with bytes in the layout of the buffer.
+         * 
+         * @param[in] offset Index of the first vertex to overwrite.
+         * @param[in] data Start of the vertices to write.
+         * @param[in] count Number of vertices to write.
+         * 
+         * @retval VertexBuffer&
+         * @returns Reference to the updated variable.
+         */
+        VertexBuffer& m_update(size_t offset, const uint8_t* data, size_t count);
+
+        /**
+         * @brief Releases the CPU side copy.
+         */
+        void m_release();
+
+        /**
+         * @brief Reads the released CPU side copy back from the GPU.
+         * Refused with an assertion on threads without a current context, the copy stays released.
+         */
+        void m_restore() const;
+
     private:
         /**
          * @property Unique Universal Identifier of this instance.
@@ -134,14 +297,35 @@ namespace bskgl {
         UUID m_uuid;
 
         /**
-         * @property GPU side id of this instance.
+         * @property GPU side storage of this instance.
          */
-        uint32_t m_glid;
+        BufferStorage m_storage;
 
         /**
-         * @property Vector of vertices stored in the buffer.
+         * @property Vertices stored in the buffer.
          */
-        std::vector<Vertex> m_vertices;
+        mutable VertexData m_vertices;
+
+        /**
+         * @property Bounds of the vertices uploaded to the GPU.
+         */
+        Bounds m_bounds;
+
+        /**
+         * @property Ranges of vertices modified since the last upload.
+         */
+        DirtyRanges m_dirty;
+
+        /**
+         * @property Residency policy of the buffer.
+         */
+        Residency m_residency = Residency::Shadowed;
+
+        /**
+         * @property Bookkeeping of the released CPU side copy.
+         */
+        mutable ResidentCopy m_released;
+
     };
 
 }
\ No newline at end of file
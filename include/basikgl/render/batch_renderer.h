@@ -0,0 +1,199 @@
+/**
+ * @file render/batch_renderer.h
+ * @brief Contains the batch renderer used for drawing large amounts of textured quads.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <basikgl/core/core.h>
+#include <basikgl/gfx/vertex.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /// @brief Forward declaration for RenderContext class.
+    class RenderContext;
+
+    /**
+     * @class BatchRenderer
+     * @brief Gathers quads into a single streaming vertex buffer and draws them with as few draw calls as possible.
+     * A batch is flushed only when the shader or texture changes, or when the vertex buffer is full.
+     */
+    class BSK_API BatchRenderer final {
+        friend RenderContext;
+    public:
+        /**
+         * @struct Statistics
+         * @brief Statistics of the current (or last finished) batch.
+         */
+        struct Statistics {
+            /**
+             * @property Number of draw calls issued.
+             */
+            size_t draw_calls = 0;
+
+            /**
+             * @property Number of quads submitted.
+             */
+            size_t quads = 0;
+        };
+
+        /**
+         * @property Default maximum number of quads drawn by a single draw call.
+         */
+        static constexpr size_t default_max_quads = 10000;
+
+    private:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] parent_context Render context responsible for the batch renderer.
+         * @param[in] max_quads Maximum number of quads drawn by a single draw call.
+         */
+        BatchRenderer(RenderContext& parent_context, size_t max_quads = default_max_quads);
+
+    public:
+        /**
+         * @brief Move Constructor
+         */
+        BatchRenderer(BatchRenderer&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         */
+        ~BatchRenderer();
+
+        BatchRenderer(const BatchRenderer& other) = delete;
+        BatchRenderer& operator=(const BatchRenderer& other) = delete;
+        BatchRenderer& operator=(BatchRenderer&& other) noexcept = delete;
+
+        /**
+         * @brief Begins a batch.
+         * Creates the GPU side buffers on first use and resets the statistics.
+         *
+         * @param[in] shader UUID of the shader used to draw the quads.
+         */
+        void begin(UUID shader);
+
+        /**
+         * @brief Sets the shader used to draw the following quads, flushes the batch if the shader changes.
+         *
+         * @param[in] shader UUID of the shader.
+         */
+        void set_shader(UUID shader);
+
+        /**
+         * @brief Submits an axis aligned quad on the xy-plane.
+         *
+         * @param[in] position Bottom left corner of the quad.
+         * @param[in] size Width and height of the quad.
+         * @param[in] texture UUID of the Texture2D to sample from, BSK_INVALID_UUID for no texture.
+         * @param[in] tex_rect Texture coordinates of the quad as (u0, v0, u1, v1), default value is the whole texture.
+         */
+        void submit_quad(
+            const glm::vec3& position, const glm::vec2& size,
+            UUID texture = BSK_INVALID_UUID,
+            const glm::vec4& tex_rect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+
+        /**
+         * @brief Submits a unit quad (from (0, 0) to (1, 1)) transformed by the given matrix.
+         *
+         * @param[in] transform Transform applied to the unit quad.
+         * @param[in] texture UUID of the Texture2D to sample from, BSK_INVALID_UUID for no texture.
+         * @param[in] tex_rect Texture coordinates of the quad as (u0, v0, u1, v1), default value is the whole texture.
+         */
+        void submit_quad(
+            const glm::mat4& transform,
+            UUID texture = BSK_INVALID_UUID,
+            const glm::vec4& tex_rect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+
+        /**
+         * @brief Draws all the pending quads.
+         */
+        void flush();
+
+        /**
+         * @brief Ends the batch, draws all the pending quads.
+         */
+        void end();
+
+        /**
+         * @retval size_t
+         * @returns Maximum number of quads drawn by a single draw call.
+         */
+        [[nodiscard]]
+        size_t max_quads() const;
+
+        /**
+         * @retval const Statistics&
+         * @returns Statistics of the current batch.
+         */
+        [[nodiscard]]
+        const Statistics& statistics() const;
+
+    private:
+        /**
+         * @brief Creates the vertex array, the static quad index buffer and the stream buffer holding the quad vertices.
+         */
+        void m_create_buffers();
+
+        /**
+         * @brief Pushes the four corners of a quad to the staging vertices.
+         *
+         * @param[in] corners Corners of the quad in counter clockwise order starting from bottom left.
+         * @param[in] texture UUID of the texture.
+         * @param[in] tex_rect Texture coordinates of the quad.
+         */
+        void m_push_quad(const glm::vec3 (&corners)[4], UUID texture, const glm::vec4& tex_rect);
+
+    private:
+        /**
+         * @property Parent context.
+         */
+        RenderContext& m_parent_ctx;
+
+        /**
+         * @property Maximum number of quads drawn by a single draw call.
+         */
+        size_t m_max_quads;
+
+        /**
+         * @property UUID of the vertex array used for streaming quads.
+         */
+        UUID m_va = BSK_INVALID_UUID;
+
+        /**
+         * @property UUID of the stream buffer the quad vertices are written to.
+         */
+        UUID m_stream = BSK_INVALID_UUID;
+
+        /**
+         * @property UUID of the shader in use.
+         */
+        UUID m_shader = BSK_INVALID_UUID;
+
+        /**
+         * @property UUID of the texture in use.
+         */
+        UUID m_texture = BSK_INVALID_UUID;
+
+        /**
+         * @property Vertices of the pending quads.
+         */
+        std::vector<Vertex> m_staging;
+
+        /**
+         * @property Statistics of the current batch.
+         */
+        Statistics m_stats;
+    };
+
+}
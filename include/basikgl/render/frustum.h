@@ -0,0 +1,146 @@
+/**
+ * @file render/frustum.h
+ * @brief Contains the view frustum used for culling draws outside the camera's view.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <basikgl/core/core.h>
+#include <basikgl/gfx/bounds.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /// @brief Forward declaration for PerspectiveCamera class.
+    class PerspectiveCamera;
+
+    /// @brief Forward declaration for PlayerCamera class.
+    class PlayerCamera;
+
+    /**
+     * @class Frustum
+     * @brief Six planes of a view frustum extracted from a view projection matrix.
+     * Plane normals point inwards and are normalized, so a plane's equation gives the signed distance of a point.
+     */
+    class BSK_API Frustum final {
+    public:
+        /**
+         * @struct Spheres
+         * @brief Bounding spheres stored as a structure of arrays, so culling can process several spheres at once.
+         */
+        struct Spheres {
+            /**
+             * @property X coordinates of the centers.
+             */
+            std::vector<float> x;
+
+            /**
+             * @property Y coordinates of the centers.
+             */
+            std::vector<float> y;
+
+            /**
+             * @property Z coordinates of the centers.
+             */
+            std::vector<float> z;
+
+            /**
+             * @property Radii of the spheres.
+             */
+            std::vector<float> radius;
+
+            /**
+             * @brief Adds a sphere.
+             *
+             * @param[in] center Center of the sphere.
+             * @param[in] r Radius of the sphere.
+             */
+            void push_back(const glm::vec3& center, float r);
+
+            /**
+             * @brief Removes all the spheres.
+             */
+            void clear();
+
+            /**
+             * @retval size_t
+             * @returns Number of spheres.
+             */
+            [[nodiscard]]
+            size_t size() const;
+        };
+
+    public:
+        /**
+         * @brief Constructor
+         * Creates a frustum which contains everything.
+         */
+        Frustum();
+
+        /**
+         * @brief Constructor
+         *
+         * @param[in] view_projection View projection matrix, OpenGL clip space conventions.
+         */
+        explicit Frustum(const glm::mat4& view_projection);
+
+        /**
+         * @brief Constructor
+         *
+         * @param[in] camera Camera whose view projection matrix is used.
+         */
+        explicit Frustum(const PerspectiveCamera& camera);
+
+        /**
+         * @brief Constructor
+         *
+         * @param[in] camera Camera whose view projection matrix is used.
+         */
+        explicit Frustum(const PlayerCamera& camera);
+
+        /**
+         * @retval const std::array<glm::vec4, 6>&
+         * @returns Left, right, bottom, top, near and far planes as (normal, distance).
+         */
+        [[nodiscard]]
+        const std::array<glm::vec4, 6>& planes() const;
+
+        /**
+         * @brief Tests a bounding box against the frustum, conservative near the frustum's corners.
+         *
+         * @param[in] bounds Bounds in the same space as the view projection matrix.
+         *
+         * @retval bool
+         * @returns False if the box is completely outside the frustum.
+         */
+        [[nodiscard]]
+        bool intersects(const Bounds& bounds) const;
+
+        /**
+         * @brief Tests many bounding spheres against the frustum.
+         *
+         * @param[in] spheres Spheres in the same space as the view projection matrix.
+         * @param[out] visible One entry per sphere, 1 if the sphere intersects the frustum else 0.
+         *
+         * @retval size_t
+         * @returns Number of visible spheres.
+         */
+        size_t cull(const Spheres& spheres, std::vector<uint8_t>& visible) const;
+
+    private:
+        /**
+         * @property Left, right, bottom, top, near and far planes.
+         */
+        std::array<glm::vec4, 6> m_planes;
+    };
+
+}
@@ -0,0 +1,121 @@
+/**
+ * @file render/lod_selector.h
+ * @brief Contains the level of detail selection by projected screen space error.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <span>
+
+#include <glm/glm.hpp>
+
+#include <basikgl/core/core.h>
+#include <basikgl/gfx/lod.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /// @brief Forward declaration for CameraBase class.
+    class CameraBase;
+
+    /**
+     * @class LodSelector
+     * @brief Picks the coarsest level of detail whose error projects to at most a threshold in pixels.
+     * A level switches to a coarser one only once it is comfortably below the threshold and back to a finer one only once it is
+     * comfortably above it, so draws near the boundary don't alternate every frame.
+     */
+    class BSK_API LodSelector final {
+    public:
+        /**
+         * @property Default largest error on screen, in pixels.
+         */
+        static constexpr float default_threshold = 1.0f;
+
+        /**
+         * @property Default width of the band around the threshold in which the previous level is kept, relative to the threshold.
+         */
+        static constexpr float default_hysteresis = 0.25f;
+
+        /**
+         * @property Previous level of a draw without history.
+         */
+        static constexpr size_t none = std::numeric_limits<size_t>::max();
+
+    public:
+        /**
+         * @brief Constructor, always selects the full mesh.
+         */
+        LodSelector();
+
+        /**
+         * @brief Constructor
+         *
+         * @param[in] camera Camera the scene is rendered with, its projection and position are captured.
+         * @param[in] viewport_height Height of the viewport in pixels.
+         * @param[in] threshold Largest error on screen, in pixels.
+         * @param[in] hysteresis Width of the band around the threshold in which the previous level is kept, relative to the threshold.
+         */
+        LodSelector(const CameraBase& camera, float viewport_height, float threshold = default_threshold, float hysteresis = default_hysteresis);
+
+        /**
+         * @brief Projects an error to the screen.
+         *
+         * @param[in] error Error in world space.
+         * @param[in] center Center of the bounding sphere of the draw, in world space.
+         * @param[in] radius Radius of the bounding sphere, the error is projected from its nearest point.
+         *
+         * @retval float
+         * @returns Error in pixels, infinite if the camera is inside the sphere.
+         */
+        [[nodiscard]]
+        float projected_error(float error, const glm::vec3& center, float radius) const;
+
+        /**
+         * @brief Selects a level of detail.
+         *
+         * @param[in] levels Levels from the full mesh to the coarsest one.
+         * @param[in] center Center of the bounding sphere of the draw, in world space.
+         * @param[in] radius Radius of the bounding sphere.
+         * @param[in] scale Largest scale of the model matrix, converts the object space errors to world space.
+         * @param[in] previous Level selected for the draw in the previous frame, @property LodSelector::none if there is none.
+         *
+         * @retval size_t
+         * @returns Index of the level to draw, 0 if there are no levels.
+         */
+        [[nodiscard]]
+        size_t select(std::span<const LodLevel> levels, const glm::vec3& center, float radius, float scale = 1.0f, size_t previous = none) const;
+
+    private:
+        /**
+         * @property Position of the camera.
+         */
+        glm::vec3 m_eye;
+
+        /**
+         * @property Pixels covered by one world unit at distance one, or at any distance for orthographic projections.
+         */
+        float m_pixels_per_unit;
+
+        /**
+         * @property If the projection divides by distance.
+         */
+        bool m_perspective;
+
+        /**
+         * @property Largest error on screen, in pixels.
+         */
+        float m_threshold;
+
+        /**
+         * @property Width of the band in which the previous level is kept, relative to the threshold.
+         */
+        float m_hysteresis;
+    };
+
+}
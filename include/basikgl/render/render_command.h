@@ -0,0 +1,118 @@
+/**
+ * @file render/render_command.h
+ * @brief Contains the commands recorded by the renderer when rendering on a dedicated thread.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <basikgl/core/core.h>
+#include <basikgl/context/asset_manager.h>
+#include <basikgl/gfx/shader.h>
+#include <basikgl/gfx/mesh_pool.h>
+#include <basikgl/gfx/indirectbuffer.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /// @brief Forward declaration for VertexArray class.
+    class VertexArray;
+
+    /// @brief Forward declaration for InstanceBuffer class.
+    class InstanceBuffer;
+
+    /// @brief Forward declaration for Texture2D class.
+    class Texture2D;
+
+    /**
+     * @struct RenderCommand
+     * @brief A recorded unit of GPU work, replayed later by the thread owning the OpenGL context.
+     * Commands hold handles to the assets they use, so assets stay alive until every command using them has executed.
+     */
+    struct BSK_API RenderCommand final {
+        /**
+         * @enum Type
+         * @brief Kind of work the command does.
+         */
+        enum class Type {
+            Draw,
+            DrawInstanced,
+            DrawPooled,
+            DrawIndirect,
+            Task
+        };
+
+        /**
+         * @property Kind of work the command does.
+         */
+        Type type = Type::Task;
+
+        /**
+         * @property Vertex array to draw.
+         */
+        AssetManager::AssetHandle<VertexArray> vertexarray;
+
+        /**
+         * @property Shader to draw with.
+         */
+        AssetManager::AssetHandle<Shader> shader;
+
+        /**
+         * @property Texture bound while drawing, nullptr for none.
+         */
+        AssetManager::AssetHandle<Texture2D> texture;
+
+        /**
+         * @property Instance buffer of an instanced draw.
+         */
+        AssetManager::AssetHandle<InstanceBuffer> instances;
+
+        /**
+         * @property Mesh pool of a pooled draw.
+         */
+        AssetManager::AssetHandle<MeshPool> pool;
+
+        /**
+         * @property Mesh of a pooled draw.
+         */
+        MeshPool::Mesh mesh;
+
+        /**
+         * @property Commands of a multi draw indirect, in the renderer's indirect buffer.
+         */
+        IndirectBuffer::Range indirect;
+
+        /**
+         * @property Number of elements to draw, or number of instances for an instanced draw.
+         */
+        size_t count = 0;
+
+        /**
+         * @property First element to draw, levels of detail start inside the index buffer.
+         */
+        size_t first = 0;
+
+        /**
+         * @property Uniform values of the shader when the command was recorded, shared by draws recorded together.
+         */
+        std::shared_ptr<const Shader::Uniforms> uniforms;
+
+        /**
+         * @property Arbitrary work executed in order with the draws.
+         */
+        std::function<void()> task;
+    };
+
+    /**
+     * @property Commands recorded for a single frame.
+     */
+    using CommandList = std::vector<RenderCommand>;
+
+}
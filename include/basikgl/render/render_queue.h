@@ -0,0 +1,158 @@
+/**
+ * @file render/render_queue.h
+ * @brief Contains the render queue used for sorting draws to minimize state changes.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include <basikgl/core/core.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /**
+     * @class RenderQueue
+     * @brief Records draw commands along with a 64-bit sort key and sorts them with a radix sort.
+     * The key is laid out (from most to least significant bits) as shader, texture, vertex array and depth,
+     * so sorted commands are grouped by the most expensive state change first.
+     */
+    class BSK_API RenderQueue final {
+    public:
+        /**
+         * @struct Command
+         * @brief A recorded draw.
+         */
+        struct Command {
+            /**
+             * @property Sort key of the command.
+             */
+            uint64_t key;
+
+            /**
+             * @property UUID of the vertex array to draw.
+             */
+            UUID vertexarray;
+
+            /**
+             * @property UUID of the shader to draw with.
+             */
+            UUID shader;
+
+            /**
+             * @property UUID of the texture bound while drawing, BSK_INVALID_UUID for none.
+             */
+            UUID texture;
+
+            /**
+             * @property Level of detail to draw, ignored if the vertex array has no levels.
+             */
+            uint32_t lod;
+        };
+
+    public:
+        /**
+         * @brief Constructor
+         */
+        RenderQueue() = default;
+
+        /**
+         * @brief Records a draw.
+         *
+         * @param[in] vertexarray UUID of the vertex array.
+         * @param[in] shader UUID of the shader.
+         * @param[in] texture UUID of the texture, BSK_INVALID_UUID for none.
+         * @param[in] depth Normalized depth in [0, 1] used to order draws sharing the same state, front to back.
+         * @param[in] lod Level of detail to draw.
+         */
+        void submit(UUID vertexarray, UUID shader, UUID texture = BSK_INVALID_UUID, float depth = 0.0f, uint32_t lod = 0);
+
+        /**
+         * @brief Sorts the recorded commands by their keys.
+         *
+         * @retval const std::vector<Command>&
+         * @returns Sorted commands.
+         */
+        const std::vector<Command>& sort();
+
+        /**
+         * @brief Removes the commands which aren't flagged to be kept, must be called before sorting.
+         *
+         * @param[in] keep One entry per command in submission order, 0 removes the command, missing entries are kept.
+         */
+        void retain(const std::vector<uint8_t>& keep);
+
+        /**
+         * @brief Removes all the recorded commands.
+         * Compact ids assigned to assets are kept so keys stay stable across frames, a map which ran out of ids is reset,
+         * so assets deleted long ago don't hold on to theirs.
+         */
+        void clear();
+
+        /**
+         * @retval size_t
+         * @returns Number of recorded commands.
+         */
+        [[nodiscard]]
+        size_t size() const;
+
+        /**
+         * @retval bool
+         * @returns True if no commands are recorded.
+         */
+        [[nodiscard]]
+        bool empty() const;
+
+    private:
+        /**
+         * @brief Returns the compact id of an asset, assigning one if it's seen for the first time.
+         * Once the ids run out, new assets share the last id until the queue is cleared, which only makes the ordering less optimal.
+         *
+         * @param[inout] ids Map of compact ids.
+         * @param[in] uuid UUID of the asset.
+         *
+         * @retval uint64_t
+         * @returns Compact 16-bit id.
+         */
+        static uint64_t m_compact_id(std::unordered_map<UUID, uint16_t>& ids, UUID uuid);
+
+    private:
+        /**
+         * @property Id shared by assets seen after the ids ran out, every lower id is assigned to one asset.
+         */
+        static constexpr uint16_t s_overflow_id = UINT16_MAX;
+
+    private:
+        /**
+         * @property Recorded commands.
+         */
+        std::vector<Command> m_commands;
+
+        /**
+         * @property Scratch buffer used by the radix sort.
+         */
+        std::vector<Command> m_scratch;
+
+        /**
+         * @property Compact ids of shaders.
+         */
+        std::unordered_map<UUID, uint16_t> m_shader_ids;
+
+        /**
+         * @property Compact ids of textures.
+         */
+        std::unordered_map<UUID, uint16_t> m_texture_ids;
+
+        /**
+         * @property Compact ids of vertex arrays.
+         */
+        std::unordered_map<UUID, uint16_t> m_va_ids;
+    };
+
+}
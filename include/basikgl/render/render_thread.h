@@ -0,0 +1,171 @@
+/**
+ * @file render/render_thread.h
+ * @brief Contains the dedicated render thread replaying recorded frames.
+ * @author Arnav Deshpande
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <basikgl/core/core.h>
+#include <basikgl/render/render_command.h>
+
+/**
+ * @namespace bskgl
+ * @brief Primary namespace for BasikGL library.
+ */
+namespace bskgl {
+
+    /// @brief Forward declaration for RenderContext class.
+    class RenderContext;
+
+    /**
+     * @class RenderThread
+     * @brief Owns the OpenGL context of a render context and replays the frames recorded by the application thread.
+     * Command lists are recycled between the two threads, so the application can record the next frame
+     * while up to frames_in_flight - 1 earlier frames are being replayed.
+     * Recording and submitting must happen from a single application thread.
+     */
+    class BSK_API RenderThread final {
+        friend RenderContext;
+    private:
+        /**
+         * @brief Constructor
+         * The thread is started by @fn RenderThread::m_start().
+         *
+         * @param[in] parent_context Render context whose OpenGL context is taken over.
+         * @param[in] frames_in_flight Number of command lists, 2 for double buffering and 3 for triple buffering.
+         */
+        RenderThread(RenderContext& parent_context, uint32_t frames_in_flight);
+
+    public:
+        /**
+         * @brief Destructor
+         * Replays every submitted frame and the commands recorded since, then stops the thread and releases the OpenGL context.
+         */
+        ~RenderThread();
+
+        RenderThread(const RenderThread& other) = delete;
+        RenderThread(RenderThread&& other) noexcept = delete;
+        RenderThread& operator=(const RenderThread& other) = delete;
+        RenderThread& operator=(RenderThread&& other) noexcept = delete;
+
+        /**
+         * @brief Appends a command to the frame being recorded.
+         *
+         * @param[in] command Command to record.
+         */
+        void record(RenderCommand&& command);
+
+        /**
+         * @brief Hands the recorded frame over to the render thread, which replays it and swaps the window buffers.
+         * Blocks only if every command list is still waiting to be replayed.
+         */
+        void submit_frame();
+
+        /**
+         * @brief Runs a task on the render thread and waits for it to finish, runs it directly if called from the render thread.
+         * The task runs before any frame that hasn't started replaying yet.
+         *
+         * @param[in] task Task to run.
+         */
+        void run_and_wait(const std::function<void()>& task);
+
+        /**
+         * @brief Blocks until every submitted frame has been replayed.
+         */
+        void wait_idle();
+
+        /**
+         * @retval bool
+         * @returns True if called from the render thread.
+         */
+        [[nodiscard]]
+        bool is_render_thread() const;
+
+        /**
+         * @retval uint32_t
+         * @returns Number of command lists.
+         */
+        [[nodiscard]]
+        uint32_t frames_in_flight() const;
+
+    private:
+        /**
+         * @brief Starts the thread, the OpenGL context must not be current on any other thread.
+         */
+        void m_start();
+
+        /**
+         * @brief Loop of the render thread.
+         */
+        void m_run();
+
+    private:
+        /**
+         * @property Parent context.
+         */
+        RenderContext& m_parent_ctx;
+
+        /**
+         * @property Command lists, one per frame in flight.
+         */
+        std::vector<CommandList> m_lists;
+
+        /**
+         * @property Index of the list being recorded by the application thread.
+         */
+        size_t m_recording;
+
+        /**
+         * @property Indices of submitted lists, oldest first.
+         */
+        std::deque<size_t> m_submitted;
+
+        /**
+         * @property Indices of lists ready to be recorded.
+         */
+        std::deque<size_t> m_free;
+
+        /**
+         * @property Task waiting to be run by the render thread, nullptr if none.
+         */
+        const std::function<void()>* m_task;
+
+        /**
+         * @property True while the render thread replays a frame.
+         */
+        bool m_busy;
+
+        /**
+         * @property Set to stop the render thread once every submitted frame has been replayed.
+         */
+        bool m_stop;
+
+        /**
+         * @property Guards the list queues, the task and the stop flag.
+         */
+        std::mutex m_mutex;
+
+        /**
+         * @property Wakes up the render thread.
+         */
+        std::condition_variable m_render_cv;
+
+        /**
+         * @property Wakes up the application thread.
+         */
+        std::condition_variable m_app_cv;
+
+        /**
+         * @property The render thread.
+         */
+        std::thread m_thread;
+    };
+
+}
@@ -1,15 +1,25 @@
 #pragma once
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #include <basikgl/core/core.h>
 #include <basikgl/context/asset_manager.h>
+#include <basikgl/render/render_queue.h>
+#include <basikgl/render/frustum.h>
+#include <basikgl/render/lod_selector.h>
+#include <basikgl/render/render_command.h>
 
 namespace bskgl {
 
     class RenderContext;
+    class RenderThread;
     class Shader;
 
     class BSK_API Renderer final {
         friend RenderContext;
+        friend RenderThread;
     private:
         Renderer(const RenderContext& parent_context);
 
@@ -21,12 +31,197 @@ namespace bskgl {
         Renderer& operator=(const Renderer& other) = delete;
         Renderer& operator=(Renderer&& other) noexcept = delete;
 
+        /**
+         * @property Shader storage binding point of the per-draw model matrices of indirect draws.
+         */
+        static constexpr uint32_t draw_data_binding = IndirectBuffer::default_binding;
+
         void render(UUID vertexarray, UUID shader);
 
+        /**
+         * @brief Renders only the first few elements of a vertex array.
+         * Draws indices if the vertex array has an index buffer, else vertices.
+         * The shader and vertex array are left bound, binds go through the context's @class GLStateCache so repeated draws skip them.
+         * If the context is threaded, the draw is recorded along with a snapshot of the shader's uniforms.
+         * 
+         * @param[in] vertexarray UUID of the vertex array.
+         * @param[in] shader UUID of the shader.
+         * @param[in] num_elements Number of indices (or vertices) to draw.
+         */
+        void render(UUID vertexarray, UUID shader, size_t num_elements);
+
+        /**
+         * @brief Renders a mesh of a mesh pool.
+         * Consecutive meshes of the same pool share the vertex array, only the draw call differs.
+         * If the context is threaded, the draw is recorded along with a snapshot of the shader's uniforms.
+         * 
+         * @param[in] pool UUID of the mesh pool.
+         * @param[in] shader UUID of the shader.
+         * @param[in] mesh Mesh returned by @fn MeshPool::allocate().
+         */
+        void render(UUID pool, UUID shader, const MeshPool::Mesh& mesh);
+
+        /**
+         * @brief Renders multiple instances of a vertex array with a single draw call.
+         * Attaches the instance buffer to the vertex array if it isn't already attached.
+         * 
+         * @param[in] vertexarray UUID of the vertex array.
+         * @param[in] shader UUID of the shader.
+         * @param[in] instance_buffer UUID of the instance buffer holding per-instance attributes.
+         * @param[in] count Number of instances to draw.
+         */
+        void render_instanced(UUID vertexarray, UUID shader, UUID instance_buffer, size_t count);
+
+        /**
+         * @brief Records a draw in the render queue, nothing is drawn until @fn Renderer::flush() is called.
+         * Uniforms are applied when the draw executes, so every queued draw sees the uniform values at flush time.
+         * 
+         * @param[in] vertexarray UUID of the vertex array.
+         * @param[in] shader UUID of the shader.
+         * @param[in] texture UUID of the Texture2D bound while drawing, BSK_INVALID_UUID for none.
+         * @param[in] depth Normalized depth in [0, 1], draws sharing the same state are ordered front to back.
+         */
+        void submit(UUID vertexarray, UUID shader, UUID texture = BSK_INVALID_UUID, float depth = 0.0f);
+
+        /**
+         * @brief Records a draw of a transformed vertex array, the model matrix is only used to place its bounds for culling.
+         * 
+         * @param[in] vertexarray UUID of the vertex array.
+         * @param[in] shader UUID of the shader.
+         * @param[in] model Model matrix the shader applies to the vertex array.
+         * @param[in] texture UUID of the Texture2D bound while drawing, BSK_INVALID_UUID for none.
+         * @param[in] depth Normalized depth in [0, 1], draws sharing the same state are ordered front to back.
+         */
+        void submit(UUID vertexarray, UUID shader, const glm::mat4& model, UUID texture = BSK_INVALID_UUID, float depth = 0.0f);
+
+        /**
+         * @brief Records a draw of a pooled mesh, nothing is drawn until @fn Renderer::flush() is called.
+         * On flush the draws are bucketed by shader, texture and pool and every bucket is issued as a single glMultiDrawElementsIndirect.
+         * The model matrix isn't a uniform, the shader reads it from the storage buffer at @property Renderer::draw_data_binding:
+         * @example layout(std430, binding = 0) readonly buffer DrawData { mat4 u_models[]; }; ... u_models[gl_DrawID]
+         * Pooled draws aren't frustum culled, the pool keeps no bounds.
+         * 
+         * @param[in] pool UUID of the mesh pool.
+         * @param[in] shader UUID of the shader.
+         * @param[in] mesh Mesh returned by @fn MeshPool::allocate().
+         * @param[in] model Model matrix of the draw.
+         * @param[in] texture UUID of the Texture2D bound while drawing, BSK_INVALID_UUID for none.
+         */
+        void submit(UUID pool, UUID shader, const MeshPool::Mesh& mesh, const glm::mat4& model, UUID texture = BSK_INVALID_UUID);
+
+        /**
+         * @brief Enables frustum culling, queued draws whose bounding sphere is outside the frustum are dropped on flush.
+         * Bounds of draws submitted without a model matrix are assumed to be in world space.
+         * 
+         * @param[in] frustum View frustum, @example Frustum(camera).
+         */
+        void set_frustum(const Frustum& frustum);
+
+        /**
+         * @brief Disables frustum culling.
+         */
+        void disable_culling();
+
+        /**
+         * @brief Enables level of detail selection, queued draws of vertex arrays with levels of detail draw the level the selector picks.
+         * The level a draw had in the previous flush feeds the hysteresis of the selector.
+         * Draws of the same vertex array are told apart by the order they're submitted in, which stays the same in a frame loop.
+         * 
+         * @param[in] selector Selector capturing the camera, @example LodSelector(camera, window_height).
+         */
+        void set_lod(const LodSelector& selector);
+
+        /**
+         * @brief Disables level of detail selection, the full index buffer is drawn.
+         */
+        void disable_lod();
+
+        /**
+         * @retval size_t
+         * @returns Number of draws dropped by frustum culling in the last flush.
+         */
+        [[nodiscard]]
+        size_t culled() const;
+
+        /**
+         * @brief Sorts the queued draws and executes them, only binding state that differs from the previous draw.
+         * Pooled draws are issued first, one multi draw per bucket.
+         */
+        void flush();
+
+    private:
+        /**
+         * @struct IndirectDraw
+         * @brief Pooled draw waiting for the next flush.
+         */
+        struct IndirectDraw {
+            UUID pool;
+            UUID shader;
+            UUID texture;
+            MeshPool::Mesh mesh;
+            glm::mat4 model;
+        };
+
+    private:
+        /**
+         * @brief Buckets the pooled draws, uploads their commands and model matrices and issues one multi draw per bucket.
+         */
+        void m_flush_indirect();
+
+        /**
+         * @brief Selects the level of detail of a queued draw and records it for the next flush.
+         * 
+         * @param[in] vertexarray Vertex array of the draw.
+         * @param[in] bounds World space bounds of the draw.
+         * @param[in] scale Largest scale of the model matrix.
+         * 
+         * @retval uint32_t
+         * @returns Level of detail, 0 if selection is disabled.
+         */
+        uint32_t m_select_lod(const VertexArray& vertexarray, const Bounds& bounds, float scale);
+
+        /**
+         * @brief Records a draw for the render thread, snapshotting the uniforms of the shader.
+         * 
+         * @param[in] command Draw command, its uniforms are filled in if not set.
+         */
+        void m_record(RenderCommand&& command) const;
+
+        /**
+         * @brief Executes recorded commands, called by the render thread.
+         * 
+         * @param[in] commands Commands to execute.
+         */
+        void m_replay(const CommandList& commands) const;
+
+        /**
+         * @brief Issues the draw call of a bound vertex array.
+         * 
+         * @param[in] vertexarray Vertex array.
+         * @param[in] num_elements Number of indices (or vertices) to draw.
+         * @param[in] instances Number of instances, 0 for a non instanced draw.
+         * @param[in] first First index (or vertex) to draw.
+         */
+        static void m_draw(const VertexArray& vertexarray, size_t num_elements, size_t instances = 0, size_t first = 0);
+
     private:
         const RenderContext& m_parent_ctx;
         AssetManager::AssetHandle<VertexArray> m_cached_va;
         AssetManager::AssetHandle<Shader> m_cached_shader;
+        AssetManager::AssetHandle<MeshPool> m_cached_pool;
+        RenderQueue m_queue;
+        Frustum m_frustum;
+        bool m_culling;
+        Frustum::Spheres m_spheres;
+        std::vector<uint8_t> m_visible;
+        size_t m_culled;
+        LodSelector m_lod_selector;
+        bool m_lod;
+        std::unordered_map<uint64_t, uint32_t> m_lod_history;
+        std::unordered_map<uint64_t, uint32_t> m_lod_next;
+        std::unordered_map<UUID, uint32_t> m_lod_occurrences;
+        std::vector<IndirectDraw> m_indirect_draws;
+        std::shared_ptr<IndirectBuffer> m_indirect;
     };
 
 }
\ No newline at end of file
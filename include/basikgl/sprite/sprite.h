@@ -35,6 +35,16 @@ namespace bskgl {
          */
         Sprite(const std::filesystem::path& path);
 
+        /**
+         * @brief Constructor
+         * Allocates zero initialized pixels to be filled through @fn Sprite::data().
+         * 
+         * @param[in] width Sprite width.
+         * @param[in] height Sprite height.
+         * @param[in] channels Number of color channels.
+         */
+        Sprite(int32_t width, int32_t height, int32_t channels);
+
         /**
          * @brief Copy Constructor
          */
@@ -84,6 +94,12 @@ namespace bskgl {
          */
         const unsigned char* data() const;
 
+        /**
+         * @retval unsigned char*
+         * @returns Pointer to the data in the sprite.
+         */
+        unsigned char* data();
+
         /**
          * @brief Reads the given image in to the sprite.
          * 
@@ -102,6 +118,21 @@ namespace bskgl {
          */
         bool is_valid() const;
 
+        /**
+         * @brief Frees the pixels, the size and number of channels are kept.
+         * 
+         * @retval Sprite&
+         * @returns Reference to the updated variable.
+         */
+        Sprite& release();
+
+    private:
+        /**
+         * @typedef PixelData
+         * @brief Owned pixels, freed the same way they were allocated (stb_image for loaded files, delete[] for allocated sprites).
+         */
+        using PixelData = std::unique_ptr<uint8_t[], void(*)(uint8_t*)>;
+
     private:
         /**
          * @property Sprite width.
@@ -121,7 +152,7 @@ namespace bskgl {
         /**
          * @property Data stored in the sprite.
          */
-        std::unique_ptr<uint8_t[]> m_data;
+        PixelData m_data;
     };
 
 } 
\ No newline at end of file
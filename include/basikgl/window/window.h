@@ -170,6 +170,11 @@ namespace bskgl {
          */
         void make_ctx_current() const;
 
+        /**
+         * @brief Detaches the context from the calling thread if it's current, so another thread can make it current.
+         */
+        void release_ctx() const;
+
         /**
          * @retval bool
          * @returns Is the window the current context.
@@ -24,26 +24,27 @@ namespace bskgl {
     void AssetManager::delete_asset(UUID uuid) {
         auto it = m_assets.find(uuid);
 
-        if (it != m_assets.end())
-            m_assets.erase(it);
-    }
+        if (it == m_assets.end())
+            return;
 
-    void AssetManager::m_bind_ctx() {
-        m_parent_ctx.bind();
+        // the last reference may be held by recorded draws, otherwise the task releases it in order
+        m_parent_ctx.execute([asset = std::move(it->second)]() mutable { asset.reset(); });
+        m_assets.erase(it);
     }
 
-    template <>
-    UUID AssetManager::create_asset<VertexArray>(const std::vector<Vertex>& vertices) {
-        return this->create_asset<VertexArray>(vertices, std::vector<uint32_t>({}));
+    void AssetManager::m_execute(const std::function<void()>& task) {
+        m_parent_ctx.execute_sync(task);
     }
 
-    template <>
-    UUID AssetManager::create_asset<VertexArray>(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
-        UUID vb_uuid = this->create_asset<VertexBuffer>(vertices);
-        UUID ib_uuid = this->create_asset<IndexBuffer>(indices);
-        UUID va_uuid = this->create_asset<VertexArray>(this->get_asset<VertexBuffer>(vb_uuid), this->get_asset<IndexBuffer>(ib_uuid));
+    UUID AssetManager::m_create_vertex_array(VertexData vertices, std::vector<uint32_t> indices, BufferUsage usage) {
+        UUID vb_uuid = m_emplace<VertexBuffer>(std::move(vertices), usage);
+        UUID ib_uuid = m_emplace<IndexBuffer>(std::move(indices), usage);
+
+        return m_create_vertex_array(this->get_asset<VertexBuffer>(vb_uuid), this->get_asset<IndexBuffer>(ib_uuid));
+    }
 
-        return va_uuid;
+    UUID AssetManager::m_create_vertex_array(AssetHandle<VertexBuffer> vbuffer, AssetHandle<IndexBuffer> ibuffer) {
+        return m_emplace<VertexArray>(std::move(vbuffer), std::move(ibuffer));
     }
 
 }
\ No newline at end of file
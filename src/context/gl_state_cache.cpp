@@ -0,0 +1,223 @@
+#include <glad/glad.h>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <context/gl_state_cache.h>
+#include <core/convert_values.h>
+
+namespace bskgl {
+
+    thread_local GLStateCache* GLStateCache::s_current = nullptr;
+
+    GLStateCache::GLStateCache(bool passthrough)
+        :
+        m_passthrough(passthrough) {
+        this->invalidate();
+    }
+
+    GLStateCache& GLStateCache::active() {
+        static thread_local GLStateCache passthrough(true);
+
+        return s_current? *s_current : passthrough;
+    }
+
+    bool GLStateCache::has_current() {
+        return s_current != nullptr;
+    }
+
+    void GLStateCache::use_program(uint32_t program) {
+        if (m_update(m_program, program))
+            glUseProgram(program);
+    }
+
+    void GLStateCache::bind_vertex_array(uint32_t vertexarray) {
+        if (!m_update(m_vertexarray, vertexarray))
+            return;
+
+        glBindVertexArray(vertexarray);
+
+        // the element array buffer binding belongs to the vertex array
+        m_element_buffer = s_unknown;
+    }
+
+    void GLStateCache::bind_buffer(uint32_t target, uint32_t buffer) {
+        uint32_t* slot = m_buffer_slot(target);
+
+        if (!slot) {
+            m_stats.issued++;
+            glBindBuffer(target, buffer);
+            return;
+        }
+
+        if (m_update(*slot, buffer))
+            glBindBuffer(target, buffer);
+    }
+
+    void GLStateCache::bind_buffer_range(uint32_t target, uint32_t index, uint32_t buffer, size_t offset, size_t size) {
+        m_stats.issued++;
+        glBindBufferRange(target, index, buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+
+        uint32_t* slot = m_buffer_slot(target);
+        if (slot && !m_passthrough)
+            *slot = buffer;
+    }
+
+    void GLStateCache::bind_texture_unit(uint32_t unit, uint32_t texture) {
+        if (unit >= max_texture_units) {
+            m_stats.issued++;
+            glBindTextureUnit(unit, texture);
+            return;
+        }
+
+        if (m_update(m_textures[unit], texture))
+            glBindTextureUnit(unit, texture);
+    }
+
+    void GLStateCache::bind_texture(uint32_t target, uint32_t texture) {
+        if (m_update(m_textures[0], texture))
+            glBindTexture(target, texture);
+    }
+
+    void GLStateCache::enable(GLTest test) {
+        for (int32_t bit = 1; bit <= static_cast<int32_t>(GLTest::DebugOutputSynchronous); bit <<= 1) {
+            if (!(static_cast<int32_t>(test) & bit))
+                continue;
+
+            if (!m_passthrough && (m_known_tests & bit) && (m_enabled_tests & bit)) {
+                m_stats.elided++;
+                continue;
+            }
+
+            m_stats.issued++;
+            glEnable(opengl::convert(static_cast<GLTest>(bit)));
+
+            m_known_tests |= bit;
+            m_enabled_tests |= bit;
+        }
+    }
+
+    void GLStateCache::disable(GLTest test) {
+        for (int32_t bit = 1; bit <= static_cast<int32_t>(GLTest::DebugOutputSynchronous); bit <<= 1) {
+            if (!(static_cast<int32_t>(test) & bit))
+                continue;
+
+            if (!m_passthrough && (m_known_tests & bit) && !(m_enabled_tests & bit)) {
+                m_stats.elided++;
+                continue;
+            }
+
+            m_stats.issued++;
+            glDisable(opengl::convert(static_cast<GLTest>(bit)));
+
+            m_known_tests |= bit;
+            m_enabled_tests &= ~bit;
+        }
+    }
+
+    void GLStateCache::set_clear_color(const glm::vec4& color) {
+        if (!m_passthrough && m_clear_color_known && m_clear_color == color) {
+            m_stats.elided++;
+            return;
+        }
+
+        m_stats.issued++;
+        glClearColor(color.r, color.g, color.b, color.a);
+
+        m_clear_color = color;
+        m_clear_color_known = true;
+    }
+
+    glm::vec4 GLStateCache::clear_color() {
+        if (m_passthrough || !m_clear_color_known) {
+            glGetFloatv(GL_COLOR_CLEAR_VALUE, glm::value_ptr(m_clear_color));
+            m_clear_color_known = !m_passthrough;
+        }
+
+        return m_clear_color;
+    }
+
+    void GLStateCache::on_buffer_deleted(uint32_t buffer) {
+        // deleting a bound buffer reverts its bindings to zero
+        for (uint32_t* slot : { &m_array_buffer, &m_element_buffer, &m_other_buffers[0], &m_other_buffers[1], &m_other_buffers[2] }) {
+            if (*slot == buffer)
+                *slot = 0;
+        }
+    }
+
+    void GLStateCache::on_vertex_array_deleted(uint32_t vertexarray) {
+        if (m_vertexarray == vertexarray) {
+            m_vertexarray = 0;
+            m_element_buffer = s_unknown;
+        }
+    }
+
+    void GLStateCache::on_vertex_array_modified(uint32_t vertexarray) {
+        if (m_vertexarray == vertexarray)
+            m_element_buffer = s_unknown;
+    }
+
+    void GLStateCache::on_program_deleted(uint32_t program) {
+        // a bound program is only flagged for deletion, the binding stays valid but its ID may be reused
+        if (m_program == program)
+            m_program = s_unknown;
+    }
+
+    void GLStateCache::on_texture_deleted(uint32_t texture) {
+        for (uint32_t& slot : m_textures) {
+            if (slot == texture)
+                slot = 0;
+        }
+    }
+
+    void GLStateCache::invalidate() {
+        m_program = s_unknown;
+        m_vertexarray = s_unknown;
+        m_array_buffer = s_unknown;
+        m_element_buffer = s_unknown;
+        m_other_buffers.fill(s_unknown);
+        m_textures.fill(s_unknown);
+        m_known_tests = 0;
+        m_enabled_tests = 0;
+        m_clear_color = glm::vec4(0.0f);
+        m_clear_color_known = false;
+    }
+
+    const GLStateCache::Statistics& GLStateCache::statistics() const {
+        return m_stats;
+    }
+
+    void GLStateCache::reset_statistics() {
+        m_stats = Statistics();
+    }
+
+    uint32_t* GLStateCache::m_buffer_slot(uint32_t target) {
+        switch (target) {
+            case GL_ARRAY_BUFFER:
+                return &m_array_buffer;
+            case GL_ELEMENT_ARRAY_BUFFER:
+                return &m_element_buffer;
+            case GL_UNIFORM_BUFFER:
+                return &m_other_buffers[0];
+            case GL_SHADER_STORAGE_BUFFER:
+                return &m_other_buffers[1];
+            case GL_DRAW_INDIRECT_BUFFER:
+                return &m_other_buffers[2];
+            default:
+                return nullptr;
+        }
+    }
+
+    bool GLStateCache::m_update(uint32_t& slot, uint32_t value) {
+        if (!m_passthrough && slot == value) {
+            m_stats.elided++;
+            return false;
+        }
+
+        m_stats.issued++;
+
+        if (!m_passthrough)
+            slot = value;
+
+        return true;
+    }
+
+}
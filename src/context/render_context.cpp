@@ -1,8 +1,11 @@
 #include <glad/glad.h>
-#include <glm/gtc/type_ptr.hpp>
 
 #include <context/render_context.h>
+#include <camera/camera.h>
+#include <gfx/uniformbuffer.h>
+#include <time/timespan.h>
 #include <core/convert_values.h>
+#include <core/error_handler.h>
 
 namespace bskgl {
 
@@ -23,22 +26,40 @@ namespace bskgl {
         window(properties.window_properties),
         asset_manager(*this),
         renderer(*this),
-        m_uuid(uuid) {
+        batch_renderer(*this),
+        m_uuid(uuid),
+        m_gl_state(),
+        m_uniform_blocks() {
         this->bind();
         this->set_clear_color(properties.clear_color);
+
+        m_frame_buffer = asset_manager.create_asset<UniformBuffer>(sizeof(FrameUniforms));
+        this->register_uniform_block(UniformBlockRegistry::frame_block, m_frame_buffer);
     }
 
     RenderContext::RenderContext(RenderContext&& other) noexcept
         :
         window(std::move(other.window)),
         asset_manager(std::move(other.asset_manager)),
-        renderer(std::move(other.renderer)) {
+        renderer(std::move(other.renderer)),
+        batch_renderer(std::move(other.batch_renderer)),
+        m_gl_state(std::move(other.m_gl_state)),
+        m_uniform_blocks(std::move(other.m_uniform_blocks)),
+        m_frame_buffer(other.m_frame_buffer) {
         this->bind();
         this->set_clear_color(other.clear_color());
     }
 
     RenderContext::~RenderContext() {
+        // assets are released on this thread, take the context back first
+        this->stop_render_thread();
+
+        // assets are destroyed after the state cache, they fall back to issuing every call
+        if (GLStateCache::s_current == &m_gl_state)
+            GLStateCache::s_current = nullptr;
 
+        if (UniformBlockRegistry::s_current == &m_uniform_blocks)
+            UniformBlockRegistry::s_current = nullptr;
     }
 
     UUID RenderContext::uuid() const {
@@ -47,24 +68,24 @@ namespace bskgl {
     
     Color RenderContext::clear_color() const {
         glm::vec4 color;
-        glGetFloatv(GL_COLOR_CLEAR_VALUE, glm::value_ptr(color));
+        this->execute_sync([this, &color]() { color = m_gl_state.clear_color(); });
+
         return Color(color);
     }
 
     void RenderContext::clear() const {
-        glClear(clear_bits(m_clearbits));
+        GLbitfield bitfield = clear_bits(m_clearbits);
+        this->execute([bitfield]() { glClear(bitfield); });
     }
 
     RenderContext& RenderContext::enable(GLTest test) {
-        glEnable(opengl::convert(test));
-        m_enabled_tests = m_enabled_tests | test;
+        this->execute([this, test]() { m_gl_state.enable(test); });
 
         return *this;
     }
 
     RenderContext& RenderContext::disable(GLTest test) {
-        glDisable(opengl::convert(test));
-        m_enabled_tests = m_enabled_tests ^ test;
+        this->execute([this, test]() { m_gl_state.disable(test); });
 
         return *this;
     }
@@ -77,13 +98,113 @@ namespace bskgl {
 
     RenderContext& RenderContext::set_clear_color(const Color& color) {
         glm::vec4 normalized = color.normalized();
-        glClearColor(normalized.r, normalized.g, normalized.b, normalized.a);
+        this->execute([this, normalized]() { m_gl_state.set_clear_color(normalized); });
 
         return *this;
     }
 
     void RenderContext::bind() const {
-        this->window.make_ctx_current();
+        // the render thread owns the context, other threads go through execute
+        if (m_render_thread && !m_render_thread->is_render_thread())
+            return;
+
+        if (!this->window.is_current_ctx())
+            this->window.make_ctx_current();
+
+        GLStateCache::s_current = &m_gl_state;
+        UniformBlockRegistry::s_current = &m_uniform_blocks;
+    }
+
+    GLStateCache& RenderContext::gl_state() const {
+        return m_gl_state;
+    }
+
+    uint32_t RenderContext::register_uniform_block(const std::string& block, UUID buffer) {
+        auto handle = asset_manager.get_asset<UniformBuffer>(buffer);
+        if (!handle)
+            BSK_WARNING("Warning: Uniform block '" + block + "' is registered without a buffer.");
+
+        uint32_t binding = UniformBlockRegistry::none;
+        this->execute_sync([this, &block, &handle, &binding]() { binding = m_uniform_blocks.m_register(block, std::move(handle)); });
+
+        return binding;
+    }
+
+    void RenderContext::unregister_uniform_block(const std::string& block) {
+        this->execute([this, block]() { m_uniform_blocks.m_unregister(block); });
+    }
+
+    void RenderContext::update_frame_uniforms(const CameraBase& camera) {
+        FrameUniforms frame;
+        frame.view = camera.view_matrix();
+        frame.projection = camera.projection_matrix();
+        frame.view_projection = frame.projection * frame.view;
+        frame.time = time_since_epoch().as_seconds();
+        frame.resolution = glm::vec2(this->window.width(), this->window.height());
+
+        // recorded in order with the draws, draws of the previous frame still read the previous camera
+        auto buffer = asset_manager.get_asset<UniformBuffer>(m_frame_buffer);
+        this->execute([buffer, frame]() { buffer->update(frame); });
+    }
+
+    UUID RenderContext::frame_uniform_buffer() const {
+        return m_frame_buffer;
+    }
+
+    void RenderContext::start_render_thread(uint32_t frames_in_flight) {
+        if (m_render_thread) {
+            BSK_WARNING("Render thread is already running.");
+            return;
+        }
+
+        // hand the context over to the render thread
+        this->window.release_ctx();
+        GLStateCache::s_current = nullptr;
+        UniformBlockRegistry::s_current = nullptr;
+
+        m_render_thread.reset(new RenderThread(*this, frames_in_flight));
+        m_render_thread->m_start();
+    }
+
+    void RenderContext::stop_render_thread() {
+        if (!m_render_thread)
+            return;
+
+        m_render_thread.reset();
+        this->bind();
+    }
+
+    RenderThread* RenderContext::render_thread() const {
+        return m_render_thread.get();
+    }
+
+    void RenderContext::execute(std::function<void()> task) const {
+        if (m_render_thread && !m_render_thread->is_render_thread()) {
+            RenderCommand command;
+            command.task = std::move(task);
+            m_render_thread->record(std::move(command));
+            return;
+        }
+
+        this->bind();
+        task();
+    }
+
+    void RenderContext::execute_sync(const std::function<void()>& task) const {
+        if (m_render_thread) {
+            m_render_thread->run_and_wait(task);
+            return;
+        }
+
+        this->bind();
+        task();
+    }
+
+    void RenderContext::end_frame() const {
+        if (m_render_thread)
+            m_render_thread->submit_frame();
+        else
+            this->window.swap_buffers();
     }
 
 }
\ No newline at end of file
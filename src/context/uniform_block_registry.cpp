@@ -0,0 +1,67 @@
+#include <context/uniform_block_registry.h>
+#include <gfx/uniformbuffer.h>
+
+namespace bskgl {
+
+    thread_local const UniformBlockRegistry* UniformBlockRegistry::s_current = nullptr;
+
+    UniformBlockRegistry::UniformBlockRegistry()
+        :
+        m_blocks(),
+        m_free_bindings(),
+        m_next_binding(frame_binding + 1),
+        m_generation(1) { }
+
+    const UniformBlockRegistry* UniformBlockRegistry::active() {
+        return s_current;
+    }
+
+    uint32_t UniformBlockRegistry::binding(const std::string& block) const {
+        auto it = m_blocks.find(block);
+
+        return it != m_blocks.end()? it->second.binding : none;
+    }
+
+    uint64_t UniformBlockRegistry::generation() const {
+        return m_generation;
+    }
+
+    uint32_t UniformBlockRegistry::m_register(const std::string& block, std::shared_ptr<UniformBuffer> buffer) {
+        Entry& entry = m_blocks[block];
+
+        // the built-in block has a fixed binding point, so shaders can also declare it explicitly
+        if (entry.binding == none) {
+            if (block == frame_block) {
+                entry.binding = frame_binding;
+            } else if (!m_free_bindings.empty()) {
+                entry.binding = m_free_bindings.back();
+                m_free_bindings.pop_back();
+            } else {
+                entry.binding = m_next_binding++;
+            }
+
+            m_generation++;
+        }
+
+        entry.buffer = std::move(buffer);
+
+        if (entry.buffer)
+            entry.buffer->bind(entry.binding);
+
+        return entry.binding;
+    }
+
+    void UniformBlockRegistry::m_unregister(const std::string& block) {
+        auto it = m_blocks.find(block);
+
+        if (it == m_blocks.end())
+            return;
+
+        if (it->second.binding != frame_binding)
+            m_free_bindings.push_back(it->second.binding);
+
+        m_blocks.erase(it);
+        m_generation++;
+    }
+
+}
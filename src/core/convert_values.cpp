@@ -202,6 +202,32 @@ namespace bskgl::opengl {
         }
     }
 
+    int32_t convert(BufferUsage usage) {
+        switch (usage) {
+            case BufferUsage::Static:
+                return GL_STATIC_DRAW;
+            case BufferUsage::Dynamic:
+                return GL_DYNAMIC_DRAW;
+            case BufferUsage::Stream:
+                return GL_STREAM_DRAW;
+            default:
+                BSK_WARNING("Unsupported buffer usage.")
+                return -1;
+        }
+    }
+
+    int32_t convert(IndexType type) {
+        switch (type) {
+            case IndexType::UnsignedShort:
+                return GL_UNSIGNED_SHORT;
+            case IndexType::UnsignedInt:
+                return GL_UNSIGNED_INT;
+            default:
+                BSK_WARNING("Unsupported index type.")
+                return -1;
+        }
+    }
+
     TextureBase::Type convert_to_basikgl_texture_type(int32_t type) {
         switch (type) {
             case GL_TEXTURE_2D:
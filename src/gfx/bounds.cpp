@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <cmath>
+
+#include <gfx/bounds.h>
+
+namespace bskgl {
+
+    Bounds Bounds::from_vertices(const std::vector<Vertex>& vertices) {
+        static const VertexLayout layout = Vertex::Format::layout();
+        return Bounds::from_vertices(reinterpret_cast<const uint8_t*>(vertices.data()), vertices.size(), layout);
+    }
+
+    Bounds Bounds::from_vertices(const VertexData& vertices) {
+        if (!vertices.data())
+            return Bounds();
+
+        return Bounds::from_vertices(vertices.data(), vertices.size(), vertices.layout());
+    }
+
+    Bounds Bounds::from_vertices(const uint8_t* data, size_t count, const VertexLayout& layout) {
+        Bounds bounds;
+
+        if (count == 0)
+            return bounds;
+
+        uint32_t stride = layout.stride();
+        bounds.min = bounds.max = layout.position(data);
+
+        for (size_t vertex = 0; vertex < count; vertex++) {
+            glm::vec3 position = layout.position(data + vertex * stride);
+            bounds.min = glm::min(bounds.min, position);
+            bounds.max = glm::max(bounds.max, position);
+        }
+
+        bounds.center = (bounds.min + bounds.max) * 0.5f;
+
+        // compare squared distances, one square root at the end
+        float radius_sq = 0.0f;
+
+        for (size_t vertex = 0; vertex < count; vertex++) {
+            glm::vec3 offset = layout.position(data + vertex * stride) - bounds.center;
+            radius_sq = std::max(radius_sq, glm::dot(offset, offset));
+        }
+
+        bounds.radius = std::sqrt(radius_sq);
+
+        return bounds;
+    }
+
+    Bounds& Bounds::expand(const glm::vec3& point) {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+        radius = std::max(radius, glm::length(point - center));
+
+        return *this;
+    }
+
+    Bounds Bounds::transformed(const glm::mat4& model) const {
+        Bounds bounds;
+
+        glm::vec3 extent = (max - min) * 0.5f;
+        glm::vec3 box_center = glm::vec3(model * glm::vec4((min + max) * 0.5f, 1.0f));
+        glm::vec3 box_extent = glm::vec3(0.0f);
+
+        // the extent along each world axis is the sum of the absolute projections of the local extents
+        for (int32_t column = 0; column < 3; column++) {
+            for (int32_t row = 0; row < 3; row++)
+                box_extent[row] += std::abs(model[column][row]) * extent[column];
+        }
+
+        bounds.min = box_center - box_extent;
+        bounds.max = box_center + box_extent;
+        bounds.center = glm::vec3(model * glm::vec4(center, 1.0f));
+
+        // non-uniform scale grows the sphere by the largest axis scale
+        float scale = std::max({
+            glm::length(glm::vec3(model[0])),
+            glm::length(glm::vec3(model[1])),
+            glm::length(glm::vec3(model[2]))
+        });
+        bounds.radius = radius * scale;
+
+        return bounds;
+    }
+
+}
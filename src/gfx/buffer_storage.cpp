@@ -0,0 +1,171 @@
+#include <glad/glad.h>
+
+#include <gfx/buffer_storage.h>
+#include <context/gl_state_cache.h>
+#include <core/convert_values.h>
+
+namespace bskgl {
+
+    BufferStorage::BufferStorage(BufferUsage usage)
+        :
+        m_glid(0),
+        m_usage(usage),
+        m_size(0),
+        m_immutable(false) {
+        glCreateBuffers(1, &m_glid);
+    }
+
+    BufferStorage::BufferStorage(BufferStorage&& other) noexcept
+        :
+        m_glid(other.m_glid),
+        m_usage(other.m_usage),
+        m_size(other.m_size),
+        m_immutable(other.m_immutable) {
+        other.m_glid = 0;
+    }
+
+    BufferStorage& BufferStorage::operator=(BufferStorage&& other) noexcept {
+        if (this == &other)
+            return *this;
+
+        m_release();
+
+        m_glid = other.m_glid;
+        m_usage = other.m_usage;
+        m_size = other.m_size;
+        m_immutable = other.m_immutable;
+
+        other.m_glid = 0;
+
+        return *this;
+    }
+
+    BufferStorage::~BufferStorage() {
+        m_release();
+    }
+
+    uint32_t BufferStorage::gl_id() const {
+        return m_glid;
+    }
+
+    BufferUsage BufferStorage::usage() const {
+        return m_usage;
+    }
+
+    size_t BufferStorage::size() const {
+        return m_size;
+    }
+
+    bool BufferStorage::needs_full_upload(size_t size, const DirtyRanges& dirty) const {
+        return size != m_size || dirty.all() || m_usage == BufferUsage::Stream;
+    }
+
+    bool BufferStorage::upload(const void* data, size_t size, const DirtyRanges& dirty, size_t element_size) {
+        bool full = this->needs_full_upload(size, dirty);
+
+        if (!full && dirty.empty())
+            return false;
+
+        if (full) {
+            m_allocate(data, size);
+            return true;
+        }
+
+        if (m_immutable) {
+            m_stage(data, dirty.ranges(), element_size);
+            return false;
+        }
+
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+        for (const DirtyRanges::Range& range : dirty.ranges())
+            glNamedBufferSubData(m_glid, range.begin * element_size, (range.end - range.begin) * element_size, bytes + range.begin * element_size);
+
+        return false;
+    }
+
+    void BufferStorage::read(void* data) const {
+        if (m_size == 0)
+            return;
+
+        glGetNamedBufferSubData(m_glid, 0, m_size, data);
+    }
+
+    void BufferStorage::m_allocate(const void* data, size_t size) {
+        if (m_usage == BufferUsage::Static) {
+            if (m_immutable && size == m_size) {
+                // same size, overwrite the immutable storage through a staging copy
+                m_stage(data, { { 0, size } }, 1);
+                return;
+            }
+
+            // immutable storage can't be reallocated, replace the buffer object
+            if (m_immutable) {
+                m_release();
+                glCreateBuffers(1, &m_glid);
+                m_immutable = false;
+            }
+
+            m_size = size;
+
+            // zero sized storage is invalid, the buffer stays empty until it has data
+            if (size == 0)
+                return;
+
+            glNamedBufferStorage(m_glid, size, data, 0);
+            m_immutable = true;
+
+            return;
+        }
+
+        if (m_usage == BufferUsage::Stream && size == m_size) {
+            // orphan the old storage so the driver doesn't wait for draws still reading it
+            glNamedBufferData(m_glid, size, nullptr, opengl::convert(m_usage));
+            glNamedBufferSubData(m_glid, 0, size, data);
+        }
+        else
+            glNamedBufferData(m_glid, size, data, opengl::convert(m_usage));
+
+        m_size = size;
+    }
+
+    void BufferStorage::m_stage(const void* data, const std::vector<DirtyRanges::Range>& ranges, size_t element_size) {
+        size_t staging_size = 0;
+        for (const DirtyRanges::Range& range : ranges)
+            staging_size += (range.end - range.begin) * element_size;
+
+        if (staging_size == 0)
+            return;
+
+        uint32_t staging = 0;
+        glCreateBuffers(1, &staging);
+        glNamedBufferData(staging, staging_size, nullptr, GL_STREAM_COPY);
+
+        // pack the ranges into the staging buffer, then copy each one to its place
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        size_t staging_offset = 0;
+
+        for (const DirtyRanges::Range& range : ranges) {
+            size_t offset = range.begin * element_size;
+            size_t length = (range.end - range.begin) * element_size;
+
+            glNamedBufferSubData(staging, staging_offset, length, bytes + offset);
+            glCopyNamedBufferSubData(staging, m_glid, staging_offset, offset, length);
+
+            staging_offset += length;
+        }
+
+        glDeleteBuffers(1, &staging);
+        GLStateCache::active().on_buffer_deleted(staging);
+    }
+
+    void BufferStorage::m_release() {
+        if (m_glid == 0)
+            return;
+
+        glDeleteBuffers(1, &m_glid);
+        GLStateCache::active().on_buffer_deleted(m_glid);
+        m_glid = 0;
+    }
+
+}
@@ -0,0 +1,56 @@
+#include <algorithm>
+
+#include <gfx/dirty_ranges.h>
+
+namespace bskgl {
+
+    DirtyRanges::DirtyRanges(size_t merge_gap)
+        :
+        m_ranges(),
+        m_merge_gap(merge_gap),
+        m_all(true) { }
+
+    void DirtyRanges::mark(size_t begin, size_t end) {
+        if (m_all || begin >= end)
+            return;
+
+        // first range which ends close enough to be merged
+        auto first = std::lower_bound(m_ranges.begin(), m_ranges.end(), begin,
+            [this](const Range& range, size_t value) { return range.end + m_merge_gap < value; });
+
+        Range merged = { begin, end };
+        auto last = first;
+
+        while (last != m_ranges.end() && last->begin <= merged.end + m_merge_gap) {
+            merged.begin = std::min(merged.begin, last->begin);
+            merged.end = std::max(merged.end, last->end);
+            last++;
+        }
+
+        first = m_ranges.erase(first, last);
+        m_ranges.insert(first, merged);
+    }
+
+    void DirtyRanges::mark_all() {
+        m_all = true;
+        m_ranges.clear();
+    }
+
+    bool DirtyRanges::all() const {
+        return m_all;
+    }
+
+    bool DirtyRanges::empty() const {
+        return !m_all && m_ranges.empty();
+    }
+
+    const std::vector<DirtyRanges::Range>& DirtyRanges::ranges() const {
+        return m_ranges;
+    }
+
+    void DirtyRanges::clear() {
+        m_all = false;
+        m_ranges.clear();
+    }
+
+}
@@ -1,29 +1,87 @@
 #include <glad/glad.h>
 
+#include <algorithm>
+#include <memory>
+
 #include <gfx/indexbuffer.h>
+#include <context/gl_state_cache.h>
+#include <core/error_handler.h>
+
+#if defined(BSK_SIMD_SSE2)
+    #include <emmintrin.h>
+#endif
 
 namespace bskgl {
 
-    IndexBuffer::IndexBuffer(UUID uuid, size_t num_indices)
+    // returns if every index fits in 16 bits
+    static bool fits_16bit(const uint32_t* indices, size_t count) {
+        uint32_t bits = 0;
+        size_t index = 0;
+
+#if defined(BSK_SIMD_SSE2)
+        __m128i accumulated = _mm_setzero_si128();
+
+        for (; index + 4 <= count; index += 4)
+            accumulated = _mm_or_si128(accumulated, _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + index)));
+
+        alignas(16) uint32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), accumulated);
+        bits = lanes[0] | lanes[1] | lanes[2] | lanes[3];
+#endif
+
+        for (; index < count; index++)
+            bits |= indices[index];
+
+        return bits <= 0xFFFFu;
+    }
+
+    // narrows indices that fit in 16 bits
+    static void narrow_16bit(const uint32_t* indices, size_t count, uint16_t* narrowed) {
+        size_t index = 0;
+
+#if defined(BSK_SIMD_SSE2)
+        // packs saturates signed values, biasing by 0x8000 moves [0, 65535] into its range and back
+        const __m128i bias32 = _mm_set1_epi32(0x8000);
+        const __m128i bias16 = _mm_set1_epi16(-0x8000);
+
+        for (; index + 8 <= count; index += 8) {
+            __m128i low = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + index)), bias32);
+            __m128i high = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + index + 4)), bias32);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(narrowed + index), _mm_add_epi16(_mm_packs_epi32(low, high), bias16));
+        }
+#endif
+
+        for (; index < count; index++)
+            narrowed[index] = static_cast<uint16_t>(indices[index]);
+    }
+
+    IndexBuffer::IndexBuffer(UUID uuid, size_t num_indices, BufferUsage usage)
         :
         m_uuid(uuid),
-        m_indices(num_indices, 0u) {
-        glGenBuffers(1, &m_glid);
-    }
+        m_storage(usage),
+        m_indices(num_indices, 0u) { }
 
-    IndexBuffer::IndexBuffer(UUID uuid, const std::vector<uint32_t>& indices)
+    IndexBuffer::IndexBuffer(UUID uuid, const std::vector<uint32_t>& indices, BufferUsage usage)
         :
         m_uuid(uuid),
-        m_indices(indices) {
-        glGenBuffers(1, &m_glid);
-    }
+        m_storage(usage),
+        m_indices(indices) { }
+
+    IndexBuffer::IndexBuffer(UUID uuid, std::vector<uint32_t>&& indices, BufferUsage usage)
+        :
+        m_uuid(uuid),
+        m_storage(usage),
+        m_indices(std::move(indices)) { }
 
     IndexBuffer::IndexBuffer(IndexBuffer&& other) noexcept 
         :
         m_uuid(other.m_uuid),
-        m_glid(other.m_glid),
-        m_indices(std::move(other.m_indices)) {
-        other.m_glid = 0;
+        m_storage(std::move(other.m_storage)),
+        m_indices(std::move(other.m_indices)),
+        m_dirty(std::move(other.m_dirty)),
+        m_type(other.m_type),
+        m_residency(other.m_residency),
+        m_released(std::move(other.m_released)) {
     }
 
     IndexBuffer& IndexBuffer::operator=(IndexBuffer&& other) noexcept {
@@ -31,60 +89,167 @@ namespace bskgl {
             return *this;
 
         m_uuid = other.m_uuid;
-        m_glid = other.m_glid;
+        m_storage = std::move(other.m_storage);
         m_indices = std::move(other.m_indices);
-
-        other.m_glid = 0;
+        m_dirty = std::move(other.m_dirty);
+        m_type = other.m_type;
+        m_residency = other.m_residency;
+        m_released = std::move(other.m_released);
 
         return *this;
     }
 
-    IndexBuffer::~IndexBuffer() {
-        if (m_glid != 0)
-            glDeleteBuffers(1, &m_glid);
-    }
+    IndexBuffer::~IndexBuffer() = default;
 
     UUID IndexBuffer::uuid() const {
         return m_uuid;
     }
 
     uint32_t IndexBuffer::gl_id() const {
-        return m_glid;
+        return m_storage.gl_id();
+    }
+
+    BufferUsage IndexBuffer::usage() const {
+        return m_storage.usage();
+    }
+
+    IndexType IndexBuffer::index_type() const {
+        return m_type;
+    }
+
+    Residency IndexBuffer::residency() const {
+        return m_residency;
+    }
+
+    IndexBuffer& IndexBuffer::set_residency(Residency residency) {
+        m_residency = residency;
+
+        if (m_residency == Residency::Shadowed)
+            m_restore();
+        else if (m_dirty.empty())
+            m_release();
+
+        return *this;
     }
 
     const std::vector<uint32_t>& IndexBuffer::indices() const {
+        m_restore();
         return m_indices;
     }
 
     size_t IndexBuffer::num_indices() const {
-        return m_indices.size();
+        return m_released.released() ? m_released.bytes() / sizeof(uint32_t) : m_indices.size();
     }
 
     IndexBuffer& IndexBuffer::set_indices(const std::vector<uint32_t>& indices) {
-        m_indices = indices;
+        return this->set_indices(std::vector<uint32_t>(indices));
+    }
+
+    IndexBuffer& IndexBuffer::set_indices(std::vector<uint32_t>&& indices) {
+        // the released copy is replaced, there's nothing to read back
+        m_released.discard();
+
+        m_indices = std::move(indices);
+        m_dirty.mark_all();
+
+        return *this;
+    }
+
+    IndexBuffer& IndexBuffer::update_indices(size_t offset, std::span<const uint32_t> indices) {
+        m_restore();
+
+        if (offset > m_indices.size() || indices.size() > m_indices.size() - offset) {
+            BSK_ERROR("Index update is out of the buffer range.");
+            return *this;
+        }
+
+        std::copy(indices.begin(), indices.end(), m_indices.begin() + offset);
+        m_dirty.mark(offset, offset + indices.size());
 
         return *this;
     }
 
     void IndexBuffer::bind() const {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_glid);
+        GLStateCache::active().bind_buffer(GL_ELEMENT_ARRAY_BUFFER, m_storage.gl_id());
     }
 
     IndexBuffer& IndexBuffer::sync() {
-        // bind the buffer
-        this->bind();
-
-        // update the buffer
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(uint32_t), m_indices.data(), GL_DYNAMIC_DRAW);
+        // a released copy hasn't been modified since it was uploaded
+        if (m_released.released())
+            return *this;
 
-        // unbind the buffer
-        IndexBuffer::unbind();
+        size_t count = m_indices.size();
+        size_t index_size = m_type == IndexType::UnsignedShort ? sizeof(uint16_t) : sizeof(uint32_t);
+        bool full = m_storage.needs_full_upload(count * index_size, m_dirty);
+
+        // a 16 bit buffer can only be patched with indices that fit
+        if (!full && m_type == IndexType::UnsignedShort) {
+            for (const DirtyRanges::Range& range : m_dirty.ranges()) {
+                if (!fits_16bit(m_indices.data() + range.begin, range.end - range.begin)) {
+                    full = true;
+                    break;
+                }
+            }
+        }
+
+        // the type is only picked when everything is uploaded anyway
+        if (full) {
+            m_type = fits_16bit(m_indices.data(), count) ? IndexType::UnsignedShort : IndexType::UnsignedInt;
+            m_dirty.mark_all();
+        }
+
+        // upload the modified indices
+        if (m_type == IndexType::UnsignedInt) {
+            m_storage.upload(m_indices.data(), count * sizeof(uint32_t), m_dirty, sizeof(uint32_t));
+        } else {
+            // only the uploaded ranges are narrowed, the rest of the scratch is never read
+            auto narrowed = std::make_unique_for_overwrite<uint16_t[]>(count);
+
+            if (full) {
+                narrow_16bit(m_indices.data(), count, narrowed.get());
+            } else {
+                for (const DirtyRanges::Range& range : m_dirty.ranges())
+                    narrow_16bit(m_indices.data() + range.begin, range.end - range.begin, narrowed.get() + range.begin);
+            }
+
+            m_storage.upload(narrowed.get(), count * sizeof(uint16_t), m_dirty, sizeof(uint16_t));
+        }
+
+        m_dirty.clear();
+
+        if (m_residency == Residency::GPUOnly)
+            m_release();
 
         return *this;
     }
 
     void IndexBuffer::unbind() {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        GLStateCache::active().bind_buffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+
+    void IndexBuffer::m_release() {
+        if (m_released.released() || m_indices.empty())
+            return;
+
+        m_released.release(m_indices.size() * sizeof(uint32_t));
+        std::vector<uint32_t>().swap(m_indices);
+    }
+
+    void IndexBuffer::m_restore() const {
+        if (!m_released.can_read_back("Released indices"))
+            return;
+
+        m_indices.resize(m_released.bytes() / sizeof(uint32_t));
+
+        if (m_type == IndexType::UnsignedShort) {
+            std::vector<uint16_t> narrowed(m_indices.size());
+            m_storage.read(narrowed.data());
+            std::copy(narrowed.begin(), narrowed.end(), m_indices.begin());
+        } else {
+            m_storage.read(m_indices.data());
+        }
+
+        m_released.restored();
     }
 
 }
\ No newline at end of file
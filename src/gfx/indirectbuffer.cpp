@@ -0,0 +1,110 @@
+#include <glad/glad.h>
+
+#include <bit>
+
+#include <gfx/indirectbuffer.h>
+#include <context/gl_state_cache.h>
+
+namespace bskgl {
+
+    IndirectBuffer::IndirectBuffer()
+        :
+        m_commands_glid(0),
+        m_data_glid(0),
+        m_commands_capacity(0),
+        m_data_capacity(0) { }
+
+    IndirectBuffer::IndirectBuffer(IndirectBuffer&& other) noexcept
+        :
+        m_commands_glid(other.m_commands_glid),
+        m_data_glid(other.m_data_glid),
+        m_commands_capacity(other.m_commands_capacity),
+        m_data_capacity(other.m_data_capacity) {
+        other.m_commands_glid = 0;
+        other.m_data_glid = 0;
+        other.m_commands_capacity = 0;
+        other.m_data_capacity = 0;
+    }
+
+    IndirectBuffer& IndirectBuffer::operator=(IndirectBuffer&& other) noexcept {
+        if (this == &other)
+            return *this;
+
+        m_release();
+
+        m_commands_glid = other.m_commands_glid;
+        m_data_glid = other.m_data_glid;
+        m_commands_capacity = other.m_commands_capacity;
+        m_data_capacity = other.m_data_capacity;
+
+        other.m_commands_glid = 0;
+        other.m_data_glid = 0;
+        other.m_commands_capacity = 0;
+        other.m_data_capacity = 0;
+
+        return *this;
+    }
+
+    IndirectBuffer::~IndirectBuffer() {
+        m_release();
+    }
+
+    uint32_t IndirectBuffer::gl_id() const {
+        return m_commands_glid;
+    }
+
+    uint32_t IndirectBuffer::data_gl_id() const {
+        return m_data_glid;
+    }
+
+    void IndirectBuffer::upload(std::span<const DrawElementsIndirectCommand> commands, std::span<const uint8_t> draw_data) {
+        IndirectBuffer::m_upload(m_commands_glid, m_commands_capacity, commands.data(), commands.size_bytes());
+        IndirectBuffer::m_upload(m_data_glid, m_data_capacity, draw_data.data(), draw_data.size_bytes());
+    }
+
+    void IndirectBuffer::draw(const Range& range, uint32_t binding) const {
+        if (range.num_commands == 0 || m_commands_glid == 0)
+            return;
+
+        GLStateCache& cache = GLStateCache::active();
+
+        cache.bind_buffer(GL_DRAW_INDIRECT_BUFFER, m_commands_glid);
+
+        // gl_DrawID of the first command indexes the first element of the bound range
+        if (range.data_size != 0)
+            cache.bind_buffer_range(GL_SHADER_STORAGE_BUFFER, binding, m_data_glid, range.data_offset, range.data_size);
+
+        const void* offset = reinterpret_cast<const void*>(range.first_command * sizeof(DrawElementsIndirectCommand));
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, offset, static_cast<GLsizei>(range.num_commands), sizeof(DrawElementsIndirectCommand));
+    }
+
+    void IndirectBuffer::m_upload(uint32_t& buffer, size_t& capacity, const void* data, size_t size) {
+        if (size == 0)
+            return;
+
+        if (buffer == 0)
+            glCreateBuffers(1, &buffer);
+
+        if (size > capacity)
+            capacity = std::bit_ceil(size);
+
+        // orphan the storage, draws of the previous upload keep reading the old one
+        glNamedBufferData(buffer, capacity, nullptr, GL_STREAM_DRAW);
+        glNamedBufferSubData(buffer, 0, size, data);
+    }
+
+    void IndirectBuffer::m_release() {
+        // never uploaded buffers don't need a context
+        for (uint32_t* buffer : { &m_commands_glid, &m_data_glid }) {
+            if (*buffer != 0) {
+                glDeleteBuffers(1, buffer);
+                GLStateCache::active().on_buffer_deleted(*buffer);
+                *buffer = 0;
+            }
+        }
+
+        m_commands_capacity = 0;
+        m_data_capacity = 0;
+    }
+
+}
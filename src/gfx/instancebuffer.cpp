@@ -0,0 +1,146 @@
+#include <glad/glad.h>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <gfx/instancebuffer.h>
+#include <context/gl_state_cache.h>
+#include <core/error_handler.h>
+
+namespace bskgl {
+
+    static size_t floats_per_instance(const std::vector<InstanceAttribute>& layout) {
+        size_t floats = 0;
+
+        for (InstanceAttribute attribute : layout)
+            floats += static_cast<size_t>(attribute) * 4;
+
+        return floats;
+    }
+
+    InstanceBuffer::InstanceBuffer(UUID uuid, const std::vector<InstanceAttribute>& layout, size_t num_instances, uint32_t first_location)
+        :
+        m_uuid(uuid),
+        m_layout(layout),
+        m_first_location(first_location),
+        m_floats_per_instance(floats_per_instance(layout)),
+        m_data(num_instances * m_floats_per_instance, 0.0f) {
+        glCreateBuffers(1, &m_glid);
+    }
+
+    InstanceBuffer::InstanceBuffer(UUID uuid, const std::vector<glm::mat4>& transforms, uint32_t first_location)
+        :
+        InstanceBuffer(uuid, std::vector<InstanceAttribute>({ InstanceAttribute::Mat4 }), transforms.size(), first_location) {
+        for (size_t i = 0; i < transforms.size(); i++)
+            this->set_attribute(i, 0, transforms[i]);
+
+        this->sync();
+    }
+
+    InstanceBuffer::InstanceBuffer(InstanceBuffer&& other) noexcept
+        :
+        m_uuid(other.m_uuid),
+        m_glid(other.m_glid),
+        m_layout(std::move(other.m_layout)),
+        m_first_location(other.m_first_location),
+        m_floats_per_instance(other.m_floats_per_instance),
+        m_data(std::move(other.m_data)) {
+        other.m_glid = 0;
+    }
+
+    InstanceBuffer& InstanceBuffer::operator=(InstanceBuffer&& other) noexcept {
+        if (this == &other)
+            return *this;
+
+        m_uuid = other.m_uuid;
+        m_glid = other.m_glid;
+        m_layout = std::move(other.m_layout);
+        m_first_location = other.m_first_location;
+        m_floats_per_instance = other.m_floats_per_instance;
+        m_data = std::move(other.m_data);
+
+        other.m_glid = 0;
+
+        return *this;
+    }
+
+    InstanceBuffer::~InstanceBuffer() {
+        if (m_glid != 0) {
+            glDeleteBuffers(1, &m_glid);
+            GLStateCache::active().on_buffer_deleted(m_glid);
+        }
+    }
+
+    UUID InstanceBuffer::uuid() const {
+        return m_uuid;
+    }
+
+    uint32_t InstanceBuffer::gl_id() const {
+        return m_glid;
+    }
+
+    const std::vector<InstanceAttribute>& InstanceBuffer::layout() const {
+        return m_layout;
+    }
+
+    uint32_t InstanceBuffer::first_location() const {
+        return m_first_location;
+    }
+
+    size_t InstanceBuffer::stride() const {
+        return m_floats_per_instance * sizeof(float);
+    }
+
+    size_t InstanceBuffer::num_instances() const {
+        return m_floats_per_instance? m_data.size() / m_floats_per_instance : 0;
+    }
+
+    InstanceBuffer& InstanceBuffer::resize(size_t num_instances) {
+        m_data.resize(num_instances * m_floats_per_instance, 0.0f);
+
+        return *this;
+    }
+
+    InstanceBuffer& InstanceBuffer::set_attribute(size_t instance, size_t attribute, const glm::vec4& value) {
+        size_t offset = m_offset_of(instance, attribute, InstanceAttribute::Vec4);
+        const float* src = glm::value_ptr(value);
+        std::copy(src, src + 4, m_data.begin() + offset);
+
+        return *this;
+    }
+
+    InstanceBuffer& InstanceBuffer::set_attribute(size_t instance, size_t attribute, const glm::mat4& value) {
+        size_t offset = m_offset_of(instance, attribute, InstanceAttribute::Mat4);
+        const float* src = glm::value_ptr(value);
+        std::copy(src, src + 16, m_data.begin() + offset);
+
+        return *this;
+    }
+
+    void InstanceBuffer::bind() const {
+        GLStateCache::active().bind_buffer(GL_ARRAY_BUFFER, m_glid);
+    }
+
+    InstanceBuffer& InstanceBuffer::sync() {
+        // update the buffer
+        glNamedBufferData(m_glid, m_data.size() * sizeof(float), m_data.data(), GL_DYNAMIC_DRAW);
+
+        return *this;
+    }
+
+    void InstanceBuffer::unbind() {
+        GLStateCache::active().bind_buffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    size_t InstanceBuffer::m_offset_of(size_t instance, size_t attribute, InstanceAttribute expected) const {
+        BSK_VERIFY(instance < this->num_instances(), "Instance index out of range.");
+        BSK_VERIFY(attribute < m_layout.size(), "Instance attribute index out of range.");
+        BSK_VERIFY(m_layout[attribute] == expected, "Instance attribute type mismatch.");
+
+        size_t offset = instance * m_floats_per_instance;
+
+        for (size_t i = 0; i < attribute; i++)
+            offset += static_cast<size_t>(m_layout[i]) * 4;
+
+        return offset;
+    }
+
+}
@@ -0,0 +1,402 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <glm/glm.hpp>
+
+#include <gfx/mesh_optimizer.h>
+#include <gfx/vertexarray.h>
+#include <core/error_handler.h>
+
+namespace bskgl {
+
+    // entries of the LRU cache Forsyth's algorithm models, larger than the FIFO it's measured on so reuse is planned ahead
+    static constexpr uint32_t k_forsyth_cache_size = 32;
+
+    static constexpr uint32_t k_invalid = std::numeric_limits<uint32_t>::max();
+
+    static float forsyth_vertex_score(int32_t cache_position, uint32_t remaining) {
+        // a vertex without triangles left is never wanted
+        if (remaining == 0)
+            return -1.0f;
+
+        float score = 0.0f;
+
+        if (cache_position >= 0) {
+            // the vertices of the last triangle get a fixed score, so strips don't fold back on themselves
+            if (cache_position < 3)
+                score = 0.75f;
+            else
+                score = std::pow(1.0f - static_cast<float>(cache_position - 3) / static_cast<float>(k_forsyth_cache_size - 3), 1.5f);
+        }
+
+        // vertices with few triangles left are finished first so they leave the cache for good
+        return score + 2.0f / std::sqrt(static_cast<float>(remaining));
+    }
+
+    // simulates one triangle on a FIFO cache, a vertex is cached while fewer than cache_size misses happened since it was loaded
+    static uint32_t simulate_triangle(std::vector<uint32_t>& timestamps, uint32_t& time, uint32_t cache_size, const uint32_t* triangle) {
+        uint32_t misses = 0;
+
+        for (int corner = 0; corner < 3; corner++) {
+            uint32_t vertex = triangle[corner];
+
+            if (time - timestamps[vertex] > cache_size) {
+                timestamps[vertex] = time++;
+                misses++;
+            }
+        }
+
+        return misses;
+    }
+
+    MeshOptimizer::Statistics MeshOptimizer::optimize(VertexData& vertices, std::vector<uint32_t>& indices, float overdraw_threshold) {
+        Statistics statistics;
+        statistics.vertices_before = statistics.vertices_after = vertices.size();
+
+        if (!vertices.data() || !MeshOptimizer::m_validate(indices, vertices.size()))
+            return statistics;
+
+        statistics.acmr_before = MeshOptimizer::acmr(indices, vertices.size());
+
+        indices = MeshOptimizer::optimize_vertex_cache(indices, vertices.size());
+
+        if (overdraw_threshold > 1.0f)
+            indices = MeshOptimizer::optimize_overdraw(indices, vertices, overdraw_threshold);
+
+        statistics.vertices_after = MeshOptimizer::optimize_vertex_fetch(indices, vertices);
+        statistics.acmr_after = MeshOptimizer::acmr(indices, statistics.vertices_after);
+
+        return statistics;
+    }
+
+    MeshOptimizer::Statistics MeshOptimizer::optimize(VertexArray& vertexarray, float overdraw_threshold) {
+        if (!vertexarray.does_ibuffer_exist()) {
+            BSK_ERROR("Only vertex arrays with an index buffer can be optimized.");
+            return Statistics();
+        }
+
+        // work on copies, the vertex array only sees the finished mesh
+        const VertexData& source = vertexarray.vertex_data();
+        std::vector<uint32_t> indices = vertexarray.indices();
+
+        // released GPU-only copies can't be read back off the context thread
+        if (!source.data() || indices.empty()) {
+            BSK_ERROR("Vertex array has no CPU copy of its mesh to optimize.");
+            return Statistics();
+        }
+
+        VertexData vertices(source.layout(), std::vector<uint8_t>(source.data(), source.data() + source.size_bytes()));
+
+        Statistics statistics = MeshOptimizer::optimize(vertices, indices, overdraw_threshold);
+
+        vertexarray.set_vertices(std::move(vertices));
+        vertexarray.set_indices(std::move(indices));
+
+        return statistics;
+    }
+
+    std::vector<uint32_t> MeshOptimizer::optimize_vertex_cache(std::span<const uint32_t> indices, size_t num_vertices) {
+        if (!MeshOptimizer::m_validate(indices, num_vertices))
+            return std::vector<uint32_t>(indices.begin(), indices.end());
+
+        size_t num_triangles = indices.size() / 3;
+
+        // triangles of every vertex, the first remaining[vertex] entries are the ones not emitted yet
+        std::vector<uint32_t> remaining(num_vertices, 0);
+        std::vector<uint32_t> offsets(num_vertices + 1, 0);
+        std::vector<uint32_t> adjacency(indices.size());
+
+        for (uint32_t index : indices)
+            remaining[index]++;
+
+        for (size_t vertex = 0; vertex < num_vertices; vertex++)
+            offsets[vertex + 1] = offsets[vertex] + remaining[vertex];
+
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+
+        for (size_t triangle = 0; triangle < num_triangles; triangle++) {
+            for (int corner = 0; corner < 3; corner++)
+                adjacency[fill[indices[triangle * 3 + corner]]++] = static_cast<uint32_t>(triangle);
+        }
+
+        std::vector<int32_t> cache_position(num_vertices, -1);
+        std::vector<float> vertex_score(num_vertices);
+        std::vector<float> triangle_score(num_triangles, 0.0f);
+        std::vector<uint8_t> emitted(num_triangles, 0);
+
+        for (size_t vertex = 0; vertex < num_vertices; vertex++)
+            vertex_score[vertex] = forsyth_vertex_score(-1, remaining[vertex]);
+
+        uint32_t best = k_invalid;
+        float best_score = -std::numeric_limits<float>::max();
+
+        for (size_t triangle = 0; triangle < num_triangles; triangle++) {
+            for (int corner = 0; corner < 3; corner++)
+                triangle_score[triangle] += vertex_score[indices[triangle * 3 + corner]];
+
+            if (triangle_score[triangle] > best_score) {
+                best = static_cast<uint32_t>(triangle);
+                best_score = triangle_score[triangle];
+            }
+        }
+
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+
+        std::vector<uint32_t> cache, next_cache;
+        cache.reserve(k_forsyth_cache_size + 3);
+        next_cache.reserve(k_forsyth_cache_size + 3);
+
+        size_t cursor = 0;
+
+        for (size_t count = 0; count < num_triangles; count++) {
+            // nothing in the cache has triangles left, continue with the next triangle in input order
+            if (best == k_invalid) {
+                while (emitted[cursor])
+                    cursor++;
+
+                best = static_cast<uint32_t>(cursor);
+            }
+
+            const uint32_t* triangle = &indices[best * 3];
+            result.insert(result.end(), triangle, triangle + 3);
+            emitted[best] = 1;
+
+            // drop the triangle from the remaining triangles of its vertices
+            for (int corner = 0; corner < 3; corner++) {
+                uint32_t vertex = triangle[corner];
+                uint32_t* begin = &adjacency[offsets[vertex]];
+                uint32_t* end = begin + remaining[vertex];
+
+                std::iter_swap(std::find(begin, end, best), end - 1);
+                remaining[vertex]--;
+            }
+
+            // the triangle's vertices move to the front of the cache
+            next_cache.clear();
+
+            for (int corner = 0; corner < 3; corner++) {
+                if (std::find(next_cache.begin(), next_cache.end(), triangle[corner]) == next_cache.end())
+                    next_cache.push_back(triangle[corner]);
+            }
+
+            size_t front = next_cache.size();
+
+            for (uint32_t vertex : cache) {
+                if (std::find(next_cache.begin(), next_cache.begin() + front, vertex) == next_cache.begin() + front)
+                    next_cache.push_back(vertex);
+            }
+
+            for (size_t position = 0; position < next_cache.size(); position++)
+                cache_position[next_cache[position]] = position < k_forsyth_cache_size ? static_cast<int32_t>(position) : -1;
+
+            // rescore the vertices that moved, including the ones pushed out of the cache
+            for (uint32_t vertex : next_cache) {
+                float score = forsyth_vertex_score(cache_position[vertex], remaining[vertex]);
+                float delta = score - vertex_score[vertex];
+                vertex_score[vertex] = score;
+
+                for (uint32_t live = 0; live < remaining[vertex]; live++)
+                    triangle_score[adjacency[offsets[vertex] + live]] += delta;
+            }
+
+            next_cache.resize(std::min<size_t>(next_cache.size(), k_forsyth_cache_size));
+            std::swap(cache, next_cache);
+
+            // the next triangle is the best one touching the cache
+            best = k_invalid;
+            best_score = -std::numeric_limits<float>::max();
+
+            for (uint32_t vertex : cache) {
+                for (uint32_t live = 0; live < remaining[vertex]; live++) {
+                    uint32_t candidate = adjacency[offsets[vertex] + live];
+
+                    if (triangle_score[candidate] > best_score) {
+                        best = candidate;
+                        best_score = triangle_score[candidate];
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+
+    std::vector<uint32_t> MeshOptimizer::optimize_overdraw(std::span<const uint32_t> indices, const VertexData& vertices, float threshold) {
+        if (!vertices.data() || !MeshOptimizer::m_validate(indices, vertices.size()))
+            return std::vector<uint32_t>(indices.begin(), indices.end());
+
+        size_t num_triangles = indices.size() / 3;
+        if (num_triangles == 0)
+            return std::vector<uint32_t>();
+
+        std::vector<uint32_t> timestamps(vertices.size(), 0);
+        uint32_t time = default_cache_size + 1;
+
+        // hard boundaries, triangles that miss on every vertex start with a cold cache anyway
+        std::vector<uint32_t> hard = { 0 };
+
+        for (size_t triangle = 0; triangle < num_triangles; triangle++) {
+            if (simulate_triangle(timestamps, time, default_cache_size, &indices[triangle * 3]) == 3 && triangle != 0)
+                hard.push_back(static_cast<uint32_t>(triangle));
+        }
+
+        hard.push_back(static_cast<uint32_t>(num_triangles));
+
+        // soft boundaries, a cluster may end once its ACMR from a cold cache is within the threshold of the whole hard cluster
+        std::vector<uint32_t> clusters;
+
+        for (size_t cluster = 0; cluster + 1 < hard.size(); cluster++) {
+            uint32_t begin = hard[cluster];
+            uint32_t end = hard[cluster + 1];
+
+            time += default_cache_size + 1;
+            uint32_t misses = 0;
+
+            for (uint32_t triangle = begin; triangle < end; triangle++)
+                misses += simulate_triangle(timestamps, time, default_cache_size, &indices[triangle * 3]);
+
+            float target = static_cast<float>(misses) / static_cast<float>(end - begin) * threshold;
+
+            time += default_cache_size + 1;
+            misses = 0;
+            uint32_t start = begin;
+            clusters.push_back(begin);
+
+            for (uint32_t triangle = begin; triangle < end; triangle++) {
+                misses += simulate_triangle(timestamps, time, default_cache_size, &indices[triangle * 3]);
+
+                if (triangle + 1 < end && static_cast<float>(misses) <= target * static_cast<float>(triangle + 1 - start)) {
+                    clusters.push_back(triangle + 1);
+                    start = triangle + 1;
+                    misses = 0;
+                    time += default_cache_size + 1;
+                }
+            }
+        }
+
+        clusters.push_back(static_cast<uint32_t>(num_triangles));
+
+        std::vector<glm::vec3> positions(vertices.size());
+        const VertexLayout& layout = vertices.layout();
+
+        for (size_t vertex = 0; vertex < vertices.size(); vertex++)
+            positions[vertex] = layout.position(vertices.data() + vertex * layout.stride());
+
+        // area weighted centroid and normal of every cluster
+        size_t num_clusters = clusters.size() - 1;
+        std::vector<glm::vec3> centroids(num_clusters, glm::vec3(0.0f));
+        std::vector<glm::vec3> normals(num_clusters, glm::vec3(0.0f));
+        std::vector<float> areas(num_clusters, 0.0f);
+
+        glm::vec3 mesh_centroid = glm::vec3(0.0f);
+        float mesh_area = 0.0f;
+
+        for (size_t cluster = 0; cluster < num_clusters; cluster++) {
+            for (uint32_t triangle = clusters[cluster]; triangle < clusters[cluster + 1]; triangle++) {
+                const glm::vec3& a = positions[indices[triangle * 3]];
+                const glm::vec3& b = positions[indices[triangle * 3 + 1]];
+                const glm::vec3& c = positions[indices[triangle * 3 + 2]];
+
+                glm::vec3 normal = glm::cross(b - a, c - a);
+                float area = glm::length(normal);
+
+                centroids[cluster] += (a + b + c) * (area / 3.0f);
+                normals[cluster] += normal;
+                areas[cluster] += area;
+            }
+
+            mesh_centroid += centroids[cluster];
+            mesh_area += areas[cluster];
+
+            if (areas[cluster] > 0.0f)
+                centroids[cluster] /= areas[cluster];
+        }
+
+        if (mesh_area > 0.0f)
+            mesh_centroid /= mesh_area;
+
+        // clusters facing away from the center are on the outside and likely occlude the rest, they're drawn first
+        std::vector<float> keys(num_clusters);
+
+        for (size_t cluster = 0; cluster < num_clusters; cluster++) {
+            float length = glm::length(normals[cluster]);
+            glm::vec3 normal = length > 0.0f ? normals[cluster] / length : glm::vec3(0.0f);
+            keys[cluster] = glm::dot(centroids[cluster] - mesh_centroid, normal);
+        }
+
+        std::vector<uint32_t> order(num_clusters);
+        for (size_t cluster = 0; cluster < num_clusters; cluster++)
+            order[cluster] = static_cast<uint32_t>(cluster);
+
+        std::stable_sort(order.begin(), order.end(), [&keys](uint32_t a, uint32_t b) { return keys[a] > keys[b]; });
+
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+
+        for (uint32_t cluster : order)
+            result.insert(result.end(), indices.begin() + clusters[cluster] * 3, indices.begin() + clusters[cluster + 1] * 3);
+
+        return result;
+    }
+
+    size_t MeshOptimizer::optimize_vertex_fetch(std::span<uint32_t> indices, VertexData& vertices) {
+        if (!vertices.data() || !MeshOptimizer::m_validate(indices, vertices.size()))
+            return vertices.size();
+
+        std::vector<uint32_t> remap(vertices.size(), k_invalid);
+        uint32_t next = 0;
+
+        for (uint32_t& index : indices) {
+            if (remap[index] == k_invalid)
+                remap[index] = next++;
+
+            index = remap[index];
+        }
+
+        uint32_t stride = vertices.layout().stride();
+        std::vector<uint8_t> bytes(static_cast<size_t>(next) * stride);
+
+        for (size_t vertex = 0; vertex < vertices.size(); vertex++) {
+            if (remap[vertex] != k_invalid)
+                std::memcpy(bytes.data() + static_cast<size_t>(remap[vertex]) * stride, vertices.data() + vertex * stride, stride);
+        }
+
+        vertices = VertexData(vertices.layout(), std::move(bytes));
+
+        return next;
+    }
+
+    float MeshOptimizer::acmr(std::span<const uint32_t> indices, size_t num_vertices, uint32_t cache_size) {
+        if (indices.empty() || !MeshOptimizer::m_validate(indices, num_vertices))
+            return 0.0f;
+
+        std::vector<uint32_t> timestamps(num_vertices, 0);
+        uint32_t time = cache_size + 1;
+        size_t misses = 0;
+
+        for (size_t triangle = 0; triangle < indices.size() / 3; triangle++)
+            misses += simulate_triangle(timestamps, time, cache_size, &indices[triangle * 3]);
+
+        return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+    }
+
+    bool MeshOptimizer::m_validate(std::span<const uint32_t> indices, size_t num_vertices) {
+        if (indices.size() % 3 != 0) {
+            BSK_ERROR("Mesh optimization needs a triangle list, the number of indices isn't a multiple of three.");
+            return false;
+        }
+
+        for (uint32_t index : indices) {
+            if (index >= num_vertices) {
+                BSK_ERROR("Mesh optimization found an index outside of the vertices.");
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+}
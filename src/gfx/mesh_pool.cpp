@@ -0,0 +1,221 @@
+#include <glad/glad.h>
+
+#include <algorithm>
+
+#include <gfx/mesh_pool.h>
+#include <context/gl_state_cache.h>
+
+namespace bskgl {
+
+    MeshPool::MeshPool(UUID uuid, VertexLayout layout, size_t vertex_capacity, size_t index_capacity)
+        :
+        m_uuid(uuid),
+        m_layout(std::move(layout)),
+        m_vao(0),
+        m_vbo(0),
+        m_ibo(0),
+        m_vertex_allocator(0),
+        m_index_allocator(0),
+        m_num_meshes(0),
+        m_grows(0) {
+        glCreateVertexArrays(1, &m_vao);
+        glCreateBuffers(1, &m_vbo);
+        glCreateBuffers(1, &m_ibo);
+
+        glNamedBufferData(m_vbo, vertex_capacity * m_layout.stride(), nullptr, GL_DYNAMIC_DRAW);
+        glNamedBufferData(m_ibo, index_capacity * sizeof(uint32_t), nullptr, GL_DYNAMIC_DRAW);
+
+        m_layout.apply(m_vao);
+
+        m_vertex_allocator.grow(vertex_capacity);
+        m_index_allocator.grow(index_capacity);
+
+        this->m_attach();
+    }
+
+    MeshPool::MeshPool(MeshPool&& other) noexcept
+        :
+        m_uuid(other.m_uuid),
+        m_layout(std::move(other.m_layout)),
+        m_vao(other.m_vao),
+        m_vbo(other.m_vbo),
+        m_ibo(other.m_ibo),
+        m_vertex_allocator(std::move(other.m_vertex_allocator)),
+        m_index_allocator(std::move(other.m_index_allocator)),
+        m_num_meshes(other.m_num_meshes),
+        m_grows(other.m_grows) {
+        other.m_vao = 0;
+        other.m_vbo = 0;
+        other.m_ibo = 0;
+    }
+
+    MeshPool& MeshPool::operator=(MeshPool&& other) noexcept {
+        if (this == &other)
+            return *this;
+
+        m_release();
+
+        m_uuid = other.m_uuid;
+        m_layout = std::move(other.m_layout);
+        m_vao = other.m_vao;
+        m_vbo = other.m_vbo;
+        m_ibo = other.m_ibo;
+        m_vertex_allocator = std::move(other.m_vertex_allocator);
+        m_index_allocator = std::move(other.m_index_allocator);
+        m_num_meshes = other.m_num_meshes;
+        m_grows = other.m_grows;
+
+        other.m_vao = 0;
+        other.m_vbo = 0;
+        other.m_ibo = 0;
+
+        return *this;
+    }
+
+    MeshPool::~MeshPool() {
+        m_release();
+    }
+
+    UUID MeshPool::uuid() const {
+        return m_uuid;
+    }
+
+    uint32_t MeshPool::gl_id() const {
+        return m_vao;
+    }
+
+    const VertexLayout& MeshPool::layout() const {
+        return m_layout;
+    }
+
+    MeshPool::Mesh MeshPool::allocate(const VertexData& vertices, std::span<const uint32_t> indices) {
+        if (!(vertices.layout() == m_layout)) {
+            BSK_ERROR("Vertex data doesn't match the layout of the mesh pool.");
+            return Mesh();
+        }
+
+        return this->m_allocate(vertices.data(), vertices.size(), indices);
+    }
+
+    void MeshPool::free(const Mesh& mesh) {
+        if (!mesh.is_valid())
+            return;
+
+        m_vertex_allocator.free(mesh.base_vertex, mesh.num_vertices);
+        m_index_allocator.free(mesh.first_index, mesh.num_indices);
+        m_num_meshes--;
+    }
+
+    void MeshPool::bind() const {
+        GLStateCache::active().bind_vertex_array(m_vao);
+    }
+
+    void MeshPool::draw(const Mesh& mesh, size_t instances) const {
+        if (!mesh.is_valid())
+            return;
+
+        const void* offset = reinterpret_cast<const void*>(static_cast<uintptr_t>(mesh.first_index) * sizeof(uint32_t));
+
+        if (instances)
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, mesh.num_indices, GL_UNSIGNED_INT, offset, static_cast<GLsizei>(instances), mesh.base_vertex);
+        else
+            glDrawElementsBaseVertex(GL_TRIANGLES, mesh.num_indices, GL_UNSIGNED_INT, offset, mesh.base_vertex);
+    }
+
+    MeshPool::Statistics MeshPool::statistics() const {
+        Statistics statistics;
+        statistics.vertices = m_vertex_allocator.statistics();
+        statistics.indices = m_index_allocator.statistics();
+        statistics.num_meshes = m_num_meshes;
+        statistics.grows = m_grows;
+
+        return statistics;
+    }
+
+    void MeshPool::unbind() {
+        GLStateCache::active().bind_vertex_array(0);
+    }
+
+    MeshPool::Mesh MeshPool::m_allocate(const uint8_t* vertices, size_t num_vertices, std::span<const uint32_t> indices) {
+        if (!vertices || num_vertices == 0 || indices.empty()) {
+            BSK_ERROR("Mesh pools only hold indexed meshes with resident vertices.");
+            return Mesh();
+        }
+
+        for (uint32_t index : indices) {
+            if (index >= num_vertices) {
+                BSK_ERROR("Mesh index is outside of its vertices.");
+                return Mesh();
+            }
+        }
+
+        size_t stride = m_layout.stride();
+
+        Mesh mesh;
+        mesh.base_vertex = static_cast<uint32_t>(m_reserve(m_vertex_allocator, m_vbo, stride, num_vertices));
+        mesh.num_vertices = static_cast<uint32_t>(num_vertices);
+        mesh.first_index = static_cast<uint32_t>(m_reserve(m_index_allocator, m_ibo, sizeof(uint32_t), indices.size()));
+        mesh.num_indices = static_cast<uint32_t>(indices.size());
+
+        glNamedBufferSubData(m_vbo, static_cast<size_t>(mesh.base_vertex) * stride, num_vertices * stride, vertices);
+        glNamedBufferSubData(m_ibo, static_cast<size_t>(mesh.first_index) * sizeof(uint32_t), indices.size_bytes(), indices.data());
+
+        m_num_meshes++;
+
+        return mesh;
+    }
+
+    size_t MeshPool::m_reserve(RangeAllocator& allocator, uint32_t& buffer, size_t element_size, size_t size) {
+        size_t offset = allocator.allocate(size);
+        if (offset != RangeAllocator::invalid)
+            return offset;
+
+        // double the buffer, or more if the mesh alone doesn't fit
+        size_t old_capacity = allocator.capacity();
+        size_t capacity = std::max(old_capacity * 2, old_capacity + size);
+
+        uint32_t grown = 0;
+        glCreateBuffers(1, &grown);
+        glNamedBufferData(grown, capacity * element_size, nullptr, GL_DYNAMIC_DRAW);
+
+        // offsets of existing meshes stay the same
+        glCopyNamedBufferSubData(buffer, grown, 0, 0, old_capacity * element_size);
+
+        glDeleteBuffers(1, &buffer);
+        GLStateCache::active().on_buffer_deleted(buffer);
+        buffer = grown;
+
+        allocator.grow(capacity);
+        m_grows++;
+
+        this->m_attach();
+
+        return allocator.allocate(size);
+    }
+
+    void MeshPool::m_attach() {
+        glVertexArrayVertexBuffer(m_vao, 0, m_vbo, 0, m_layout.stride());
+        glVertexArrayElementBuffer(m_vao, m_ibo);
+
+        GLStateCache::active().on_vertex_array_modified(m_vao);
+    }
+
+    void MeshPool::m_release() {
+        GLStateCache& cache = GLStateCache::active();
+
+        if (m_vao != 0) {
+            glDeleteVertexArrays(1, &m_vao);
+            cache.on_vertex_array_deleted(m_vao);
+            m_vao = 0;
+        }
+
+        for (uint32_t* buffer : { &m_vbo, &m_ibo }) {
+            if (*buffer != 0) {
+                glDeleteBuffers(1, buffer);
+                cache.on_buffer_deleted(*buffer);
+                *buffer = 0;
+            }
+        }
+    }
+
+}
@@ -0,0 +1,160 @@
+#include <glad/glad.h>
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include <gfx/program_binary_cache.h>
+#include <core/error_handler.h>
+
+namespace bskgl {
+
+    /**
+     * @struct BinaryHeader
+     * @brief Precedes the program binary in a cache file.
+     */
+    struct BinaryHeader {
+        uint32_t magic = 0;
+        uint32_t format = 0;
+        uint64_t key = 0;
+        uint64_t size = 0;
+    };
+
+    static constexpr uint32_t binary_magic = 0x50475342; // "BSGP"
+
+    // FNV-1a, stable across runs unlike std::hash
+    static uint64_t hash_string(uint64_t hash, std::string_view str) {
+        for (char c : str) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 0x100000001B3ull;
+        }
+
+        // separates consecutive strings, "ab" + "c" hashes differently from "a" + "bc"
+        hash ^= 0xFF;
+        hash *= 0x100000001B3ull;
+
+        return hash;
+    }
+
+    static std::string_view gl_string(GLenum name) {
+        const GLubyte* str = glGetString(name);
+
+        return str? reinterpret_cast<const char*>(str) : "";
+    }
+
+    std::filesystem::path ProgramBinaryCache::s_directory;
+
+    void ProgramBinaryCache::enable(const std::filesystem::path& directory) {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+
+        if (error) {
+            BSK_WARNING("Warning: Could not create program binary cache directory " + directory.string() + ", " + error.message());
+            return;
+        }
+
+        s_directory = directory;
+    }
+
+    void ProgramBinaryCache::disable() {
+        s_directory.clear();
+    }
+
+    bool ProgramBinaryCache::enabled() {
+        return !s_directory.empty();
+    }
+
+    const std::filesystem::path& ProgramBinaryCache::directory() {
+        return s_directory;
+    }
+
+    uint64_t ProgramBinaryCache::m_key(const std::string& vert_source, const std::string& pixel_source) {
+        uint64_t hash = 0xCBF29CE484222325ull;
+
+        hash = hash_string(hash, vert_source);
+        hash = hash_string(hash, pixel_source);
+        hash = hash_string(hash, gl_string(GL_VENDOR));
+        hash = hash_string(hash, gl_string(GL_RENDERER));
+        hash = hash_string(hash, gl_string(GL_VERSION));
+
+        return hash;
+    }
+
+    bool ProgramBinaryCache::m_load(uint32_t program, uint64_t key) {
+        std::ifstream file(m_path(key), std::ios::binary);
+        if (!file.is_open())
+            return false;
+
+        BinaryHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        if (!file || header.magic != binary_magic || header.key != key || header.size == 0)
+            return false;
+
+        std::vector<char> binary(header.size);
+        file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+
+        if (!file)
+            return false;
+
+        glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+        // drivers reject binaries of other builds even if the version string matches
+        GLint link_result = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &link_result);
+
+        return link_result == GL_TRUE;
+    }
+
+    void ProgramBinaryCache::m_store(uint32_t program, uint64_t key) {
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+        // the driver supports no binary formats
+        if (length <= 0)
+            return;
+
+        std::vector<char> binary(static_cast<size_t>(length));
+        GLenum format = 0;
+        glGetProgramBinary(program, length, &length, &format, binary.data());
+
+        BinaryHeader header;
+        header.magic = binary_magic;
+        header.format = format;
+        header.key = key;
+        header.size = static_cast<uint64_t>(length);
+
+        // written aside and renamed, a crash never leaves a truncated binary behind
+        std::filesystem::path path = m_path(key);
+        std::filesystem::path temp_path = path;
+        temp_path += ".tmp";
+
+        {
+            std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(binary.data(), length);
+
+            if (!file)
+                BSK_WARNING("Warning: Could not write program binary " + temp_path.string());
+        }
+
+        std::error_code error;
+        if (!std::filesystem::exists(temp_path, error) || std::filesystem::file_size(temp_path, error) != sizeof(header) + header.size) {
+            std::filesystem::remove(temp_path, error);
+            return;
+        }
+
+        std::filesystem::rename(temp_path, path, error);
+
+        if (error)
+            BSK_WARNING("Warning: Could not store program binary " + path.string() + ", " + error.message());
+    }
+
+    std::filesystem::path ProgramBinaryCache::m_path(uint64_t key) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+
+        return s_directory / name;
+    }
+
+}
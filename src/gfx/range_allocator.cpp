@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <iterator>
+
+#include <gfx/range_allocator.h>
+#include <core/error_handler.h>
+
+namespace bskgl {
+
+    RangeAllocator::RangeAllocator(size_t capacity)
+        :
+        m_free(),
+        m_free_by_size(),
+        m_capacity(capacity),
+        m_used(0) {
+        if (capacity != 0)
+            m_insert(0, capacity);
+    }
+
+    size_t RangeAllocator::allocate(size_t size) {
+        if (size == 0)
+            return invalid;
+
+        // the smallest free range that fits
+        auto fit = m_free_by_size.lower_bound(size);
+        if (fit == m_free_by_size.end())
+            return invalid;
+
+        size_t offset = fit->second;
+        size_t available = fit->first;
+
+        m_erase(m_free.find(offset));
+
+        // the rest of the range stays free
+        if (available > size)
+            m_insert(offset + size, available - size);
+
+        m_used += size;
+
+        return offset;
+    }
+
+    void RangeAllocator::free(size_t offset, size_t size) {
+        if (size == 0)
+            return;
+
+        auto next = m_free.lower_bound(offset);
+
+        // a range overlapping free space was never allocated or is freed twice
+        bool overlaps_next = next != m_free.end() && next->first < offset + size;
+        bool overlaps_prev = next != m_free.begin() && std::prev(next)->first + std::prev(next)->second > offset;
+
+        if (offset + size > m_capacity || overlaps_next || overlaps_prev) {
+            BSK_ERROR("Freed range wasn't allocated.");
+            return;
+        }
+
+        m_used -= size;
+
+        // coalesce with the neighbours
+        if (next != m_free.end() && next->first == offset + size) {
+            size += next->second;
+            m_erase(next++);
+        }
+
+        if (next != m_free.begin()) {
+            auto prev = std::prev(next);
+
+            if (prev->first + prev->second == offset) {
+                offset = prev->first;
+                size += prev->second;
+                m_erase(prev);
+            }
+        }
+
+        m_insert(offset, size);
+    }
+
+    void RangeAllocator::grow(size_t capacity) {
+        if (capacity <= m_capacity)
+            return;
+
+        size_t old_capacity = m_capacity;
+        m_capacity = capacity;
+
+        // extending the free range ending at the old end keeps the space contiguous
+        m_used += capacity - old_capacity;
+        this->free(old_capacity, capacity - old_capacity);
+    }
+
+    size_t RangeAllocator::capacity() const {
+        return m_capacity;
+    }
+
+    RangeAllocator::Statistics RangeAllocator::statistics() const {
+        Statistics statistics;
+        statistics.capacity = m_capacity;
+        statistics.used = m_used;
+        statistics.free_ranges = m_free.size();
+        statistics.largest_free = m_free_by_size.empty() ? 0 : std::prev(m_free_by_size.end())->first;
+
+        size_t free = m_capacity - m_used;
+        statistics.fragmentation = free != 0 ? 1.0f - static_cast<float>(statistics.largest_free) / static_cast<float>(free) : 0.0f;
+
+        return statistics;
+    }
+
+    void RangeAllocator::m_insert(size_t offset, size_t size) {
+        m_free.emplace(offset, size);
+        m_free_by_size.emplace(size, offset);
+    }
+
+    void RangeAllocator::m_erase(std::map<size_t, size_t>::iterator range) {
+        auto [begin, end] = m_free_by_size.equal_range(range->second);
+
+        for (auto it = begin; it != end; it++) {
+            if (it->second == range->first) {
+                m_free_by_size.erase(it);
+                break;
+            }
+        }
+
+        m_free.erase(range);
+    }
+
+}
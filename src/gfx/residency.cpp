@@ -0,0 +1,87 @@
+#include <gfx/residency.h>
+#include <context/gl_state_cache.h>
+#include <core/error_handler.h>
+
+namespace bskgl {
+
+    std::atomic<size_t> ResidencyTracker::s_released_bytes = 0;
+    std::atomic<size_t> ResidencyTracker::s_restored_bytes = 0;
+    std::atomic<size_t> ResidencyTracker::s_restores = 0;
+
+    ResidencyTracker::Statistics ResidencyTracker::statistics() {
+        return { s_released_bytes.load(), s_restored_bytes.load(), s_restores.load() };
+    }
+
+    void ResidencyTracker::on_released(size_t bytes) {
+        s_released_bytes += bytes;
+    }
+
+    void ResidencyTracker::on_restored(size_t bytes) {
+        s_released_bytes -= bytes;
+        s_restored_bytes += bytes;
+        s_restores++;
+    }
+
+    void ResidencyTracker::on_discarded(size_t bytes) {
+        s_released_bytes -= bytes;
+    }
+
+    ResidentCopy::ResidentCopy(ResidentCopy&& other) noexcept
+        :
+        m_bytes(other.m_bytes) {
+        other.m_bytes = 0;
+    }
+
+    ResidentCopy& ResidentCopy::operator=(ResidentCopy&& other) noexcept {
+        if (this == &other)
+            return *this;
+
+        this->discard();
+        m_bytes = other.m_bytes;
+        other.m_bytes = 0;
+
+        return *this;
+    }
+
+    ResidentCopy::~ResidentCopy() {
+        this->discard();
+    }
+
+    bool ResidentCopy::released() const {
+        return m_bytes != 0;
+    }
+
+    size_t ResidentCopy::bytes() const {
+        return m_bytes;
+    }
+
+    void ResidentCopy::release(size_t bytes) {
+        m_bytes = bytes;
+        ResidencyTracker::on_released(m_bytes);
+    }
+
+    bool ResidentCopy::can_read_back(const std::string& what) const {
+        if (m_bytes == 0)
+            return false;
+
+        // the app thread has no context once the render thread owns it
+        bool current = GLStateCache::has_current();
+        BSK_ASSERT(current, what + " can only be read back on the thread owning the context, use RenderContext::execute_sync().");
+
+        return current;
+    }
+
+    void ResidentCopy::restored() {
+        ResidencyTracker::on_restored(m_bytes);
+        m_bytes = 0;
+    }
+
+    void ResidentCopy::discard() {
+        if (m_bytes == 0)
+            return;
+
+        ResidencyTracker::on_discarded(m_bytes);
+        m_bytes = 0;
+    }
+
+}
@@ -1,14 +1,54 @@
 #include <glad/glad.h>
 
+#include <algorithm>
+
 #include <glm/gtc/type_ptr.hpp>
 
 #include <gfx/shader.h>
+#include <gfx/program_binary_cache.h>
+#include <context/gl_state_cache.h>
+#include <context/uniform_block_registry.h>
 #include <core/error_handler.h>
 #include <utils/utils.h>
 
 namespace bskgl {
 
-    Shader::Shader(UUID uuid, const std::string& vertex_source, const std::string& pixel_source)
+    // compares uniform values, colors have no equality operator
+    static bool same_value(const Shader::UniformValue& lhs, const Shader::UniformValue& rhs) {
+        if (lhs.index() != rhs.index())
+            return false;
+
+        return std::visit([&rhs](auto&& value) {
+            using T = std::decay_t<decltype(value)>;
+            const T& other = std::get<T>(rhs);
+
+            if constexpr (std::is_same_v<T, Color>)
+                return value.rgba() == other.rgba();
+            else
+                return value == other;
+        }, lhs);
+    }
+
+    // lets the driver compile on its own threads, requested once per thread owning a context
+    static bool parallel_compile() {
+        static thread_local bool requested = false;
+
+        if (!GLAD_GL_KHR_parallel_shader_compile && !GLAD_GL_ARB_parallel_shader_compile)
+            return false;
+
+        if (!requested) {
+            if (GLAD_GL_KHR_parallel_shader_compile)
+                glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+            else
+                glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+
+            requested = true;
+        }
+
+        return true;
+    }
+
+    Shader::Shader(UUID uuid, const std::string& vertex_source, const std::string& pixel_source, bool deferred)
         :
         m_uuid(uuid),
         m_glid(glCreateProgram()),
@@ -24,10 +64,10 @@ namespace bskgl {
             return;
         }
 
-        m_compile(vertex_source, pixel_source);
+        m_compile(vertex_source, pixel_source, deferred);
     }
 
-    Shader::Shader(UUID uuid, const std::filesystem::path& vertex_path, const std::filesystem::path& pixel_path)
+    Shader::Shader(UUID uuid, const std::filesystem::path& vertex_path, const std::filesystem::path& pixel_path, bool deferred)
         :
         m_uuid(uuid),
         m_glid(glCreateProgram()),
@@ -42,7 +82,7 @@ namespace bskgl {
             BSK_ERROR("Invalid Pixel Shader Path given.");
             return;
         }
-        m_compile(utils::read_file(vertex_path), utils::read_file(pixel_path));
+        m_compile(utils::read_file(vertex_path), utils::read_file(pixel_path), deferred);
     }
 
     Shader::Shader(Shader&& other) noexcept
@@ -51,7 +91,21 @@ namespace bskgl {
         m_glid(other.m_glid),
         m_vert_glid(other.m_vert_glid),
         m_pixel_glid(other.m_pixel_glid),
-        m_uniforms(std::move(other.m_uniforms)) {
+        m_vert_source(std::move(other.m_vert_source)),
+        m_pixel_source(std::move(other.m_pixel_source)),
+        m_stages_compiled(other.m_stages_compiled),
+        m_pending(other.m_pending.load()),
+        m_binary_key(other.m_binary_key),
+        m_uniforms(std::move(other.m_uniforms)),
+        m_uniform_table(std::move(other.m_uniform_table)),
+        m_uniform_slots(std::move(other.m_uniform_slots)),
+        m_missing_uniforms(std::move(other.m_missing_uniforms)),
+        m_resident(std::move(other.m_resident)),
+        m_dirty(std::move(other.m_dirty)),
+        m_dirty_flags(std::move(other.m_dirty_flags)),
+        m_resident_stored(other.m_resident_stored),
+        m_uniform_blocks(std::move(other.m_uniform_blocks)),
+        m_block_generation(other.m_block_generation) {
         other.m_glid = other.m_vert_glid = other.m_pixel_glid = 0;
     }
 
@@ -63,7 +117,21 @@ namespace bskgl {
         m_glid = other.m_glid;
         m_vert_glid = other.m_vert_glid;
         m_pixel_glid = other.m_pixel_glid;
+        m_vert_source = std::move(other.m_vert_source);
+        m_pixel_source = std::move(other.m_pixel_source);
+        m_stages_compiled = other.m_stages_compiled;
+        m_pending = other.m_pending.load();
+        m_binary_key = other.m_binary_key;
         m_uniforms = std::move(other.m_uniforms);
+        m_uniform_table = std::move(other.m_uniform_table);
+        m_uniform_slots = std::move(other.m_uniform_slots);
+        m_missing_uniforms = std::move(other.m_missing_uniforms);
+        m_resident = std::move(other.m_resident);
+        m_dirty = std::move(other.m_dirty);
+        m_dirty_flags = std::move(other.m_dirty_flags);
+        m_resident_stored = other.m_resident_stored;
+        m_uniform_blocks = std::move(other.m_uniform_blocks);
+        m_block_generation = other.m_block_generation;
         other.m_glid = other.m_vert_glid = other.m_pixel_glid = 0;
 
         return *this;
@@ -73,6 +141,7 @@ namespace bskgl {
         glDeleteShader(m_vert_glid);
         glDeleteShader(m_pixel_glid);
         glDeleteProgram(m_glid);
+        GLStateCache::active().on_program_deleted(m_glid);
     }
 
     UUID Shader::uuid() const {
@@ -116,12 +185,40 @@ namespace bskgl {
     }
 
     Shader& Shader::set_uniform(const std::string& name, const UniformValue& value) {
-        m_uniforms[name] = value;
+        std::lock_guard lock(m_uniform_mutex);
+
+        auto stored = m_uniforms.find(name);
+
+        // setting the same value again costs nothing
+        if (stored != m_uniforms.end() && same_value(stored->second, value))
+            return *this;
+
+        if (stored != m_uniforms.end())
+            stored->second = value;
+        else
+            m_uniforms.emplace(name, value);
+
+        auto slot = m_uniform_slots.find(name);
+
+        // warn once per name, setting it every frame doesn't repeat the warning, pending programs check once linked
+        if (slot == m_uniform_slots.end()) {
+            if (!m_pending && m_missing_uniforms.insert(name).second)
+                BSK_WARNING("Warning: Uniform '" + name + "' not found in shader.");
+
+            return *this;
+        }
+
+        if (!m_dirty_flags[slot->second]) {
+            m_dirty_flags[slot->second] = 1;
+            m_dirty.push_back(slot->second);
+        }
 
         return *this;
     }
 
     Shader& Shader::remove_uniform(const std::string& name) {
+        std::lock_guard lock(m_uniform_mutex);
+
         auto it = m_uniforms.find(name);
         if (it != m_uniforms.end())
             m_uniforms.erase(it);
@@ -137,17 +234,95 @@ namespace bskgl {
         return std::nullopt;
     }
 
-    void Shader::bind() const {
-        glUseProgram(m_glid);
-        m_apply_uniforms();
+    const Shader::Uniforms& Shader::uniforms() const {
+        return m_uniforms;
+    }
+
+    const std::vector<Shader::UniformInfo>& Shader::active_uniforms() const {
+        return m_uniform_table;
+    }
+
+    const Shader::UniformInfo* Shader::uniform_info(const std::string& name) const {
+        auto it = m_uniform_slots.find(name);
+        if (it != m_uniform_slots.end())
+            return &m_uniform_table[it->second];
+
+        return nullptr;
+    }
+
+    const std::vector<std::string>& Shader::uniform_blocks() const {
+        return m_uniform_blocks;
+    }
+
+    bool Shader::ready() {
+        if (!m_pending)
+            return true;
+
+        // without the extension any status query waits for the driver, so finish right away
+        if (parallel_compile()) {
+            GLint completed = GL_FALSE;
+            glGetProgramiv(m_glid, GL_COMPLETION_STATUS_KHR, &completed);
+
+            if (completed != GL_TRUE)
+                return false;
+        }
+
+        m_finish();
+
+        return true;
+    }
+
+    bool Shader::bind() {
+        if (!this->ready())
+            return false;
+
+        GLStateCache::active().use_program(m_glid);
+        m_bind_uniform_blocks();
+
+        std::lock_guard lock(m_uniform_mutex);
+
+        // a snapshot replaced some values, compare every stored one against the program
+        if (!m_resident_stored) {
+            m_apply_uniforms(m_uniforms);
+            m_resident_stored = true;
+        } else {
+            for (uint32_t slot : m_dirty) {
+                const UniformInfo& info = m_uniform_table[slot];
+                auto stored = m_uniforms.find(info.name);
+
+                if (stored != m_uniforms.end())
+                    m_apply_uniform(slot, stored->second);
+            }
+        }
+
+        for (uint32_t slot : m_dirty)
+            m_dirty_flags[slot] = 0;
+        m_dirty.clear();
+
+        return true;
+    }
+
+    bool Shader::bind(const Uniforms& uniforms) {
+        if (!this->ready())
+            return false;
+
+        GLStateCache::active().use_program(m_glid);
+        m_bind_uniform_blocks();
+        m_apply_uniforms(uniforms);
+
+        // a snapshot of the stored uniforms leaves them resident, an older one doesn't
+        if (&uniforms != &m_uniforms)
+            m_resident_stored = false;
+
+        return true;
     }
 
     void Shader::unbind() {
-        glUseProgram(0);
+        GLStateCache::active().use_program(0);
     }
 
-    void Shader::m_compile(const std::string& vert_source, const std::string& pixel_source) {
-        static auto compile_shader =
+    void Shader::m_compile(const std::string& vert_source, const std::string& pixel_source, bool deferred) {
+        static auto submit_shader =
             [](uint32_t id, const char* src) -> bool {
                 if (id == 0 || src == NULL) {
                     BSK_ERROR("Shader compilation failed due to invalid id or null source.");
@@ -157,9 +332,69 @@ namespace bskgl {
                 // Set the shader source
                 glShaderSource(id, 1, &src, nullptr);
 
-                // Compile the shader
+                // Compile the shader, the status is checked once the program is linked
                 glCompileShader(id);
 
+                return true;
+            };
+
+        if (vert_source != "")
+            m_vert_source = vert_source;
+        if (pixel_source != "")
+            m_pixel_source = pixel_source;
+
+        // a cached binary of the same sources and driver skips compiling and linking
+        bool cached = ProgramBinaryCache::enabled() && m_vert_source != "" && m_pixel_source != "";
+        uint64_t cache_key = cached? ProgramBinaryCache::m_key(m_vert_source, m_pixel_source) : 0;
+
+        if (cached && ProgramBinaryCache::m_load(m_glid, cache_key)) {
+            m_stages_compiled = false;
+            m_reflect();
+            return;
+        }
+
+        if (deferred)
+            parallel_compile();
+
+        // stages of a program loaded from a binary were never compiled
+        bool compile_all = !m_stages_compiled;
+
+        // Compile vertex shader
+        if (vert_source != "" || (compile_all && m_vert_source != "")) {
+            bool submitted = submit_shader(m_vert_glid, m_vert_source.c_str());
+            if (!submitted)
+                return;
+        }
+
+        // Compile pixel shader
+        if (pixel_source != "" || (compile_all && m_pixel_source != "")) {
+            bool submitted = submit_shader(m_pixel_glid, m_pixel_source.c_str());
+            if (!submitted)
+                return;
+        }
+
+        m_stages_compiled = m_vert_source != "" && m_pixel_source != "";
+
+        // Attach the shaders
+        glAttachShader(m_glid, m_vert_glid);
+        glAttachShader(m_glid, m_pixel_glid);
+
+        if (cached)
+            glProgramParameteri(m_glid, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+        // Link the program, querying its status would wait for the driver
+        glLinkProgram(m_glid);
+
+        m_pending = true;
+        m_binary_key = cached? std::optional<uint64_t>(cache_key) : std::nullopt;
+
+        if (!deferred)
+            m_finish();
+    }
+
+    void Shader::m_finish() {
+        static auto check_shader =
+            [](uint32_t id) -> bool {
                 // Error handling
                 int32_t compile_result;
                 glGetShaderiv(id, GL_COMPILE_STATUS, &compile_result);
@@ -178,27 +413,11 @@ namespace bskgl {
                 return true;
             };
 
-        // Compile vertex shader
-        if (vert_source != "") {
-            bool compiled = compile_shader(m_vert_glid, vert_source.c_str());
-            if (!compiled)
-                return;
-        }
-
-        // Compile pixel shader
-        if (pixel_source != "") {
-            bool compiled = compile_shader(m_pixel_glid, pixel_source.c_str());
-            if (!compiled)
-                return;
+        if (!check_shader(m_vert_glid) || !check_shader(m_pixel_glid)) {
+            m_pending = false;
+            return;
         }
 
-        // Attach the shaders
-        glAttachShader(m_glid, m_vert_glid);
-        glAttachShader(m_glid, m_pixel_glid);
-
-        // Link the program
-        glLinkProgram(m_glid);
-
         // Error handling for linking
         int32_t link_result;
         glGetProgramiv(m_glid, GL_LINK_STATUS, &link_result);
@@ -211,9 +430,13 @@ namespace bskgl {
             glGetProgramInfoLog(m_glid, info_log_length, &info_log_length, info_log);
             BSK_ERROR(info_log);
             delete[] info_log;
+            m_pending = false;
             return;
         }
 
+        // Find the active uniforms once, uploads go through their locations
+        m_reflect();
+
         // Valide the program
         glValidateProgram(m_glid);
 
@@ -231,17 +454,105 @@ namespace bskgl {
             delete[] info_log;
             return;
         }
+
+        if (m_binary_key)
+            ProgramBinaryCache::m_store(m_glid, *m_binary_key);
+    }
+
+    void Shader::m_reflect() {
+        std::vector<UniformInfo> uniform_table;
+        std::unordered_map<std::string, uint32_t> uniform_slots;
+        std::vector<std::string> uniform_blocks;
+
+        GLint num_uniforms = 0;
+        GLint max_length = 0;
+        glGetProgramiv(m_glid, GL_ACTIVE_UNIFORMS, &num_uniforms);
+        glGetProgramiv(m_glid, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+
+        std::string name(static_cast<size_t>(std::max(max_length, 1)), '\0');
+
+        for (GLint index = 0; index < num_uniforms; index++) {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(m_glid, static_cast<GLuint>(index), max_length, &length, &size, &type, name.data());
+
+            UniformInfo info;
+            info.name = name.substr(0, length);
+            info.location = glGetUniformLocation(m_glid, info.name.c_str());
+            info.type = type;
+            info.size = size;
+
+            // members of uniform blocks are set through their buffer
+            if (info.location == -1)
+                continue;
+
+            // arrays are reported as their first element
+            if (info.name.ends_with("[0]"))
+                info.name.resize(info.name.size() - 3);
+
+            uniform_slots.emplace(info.name, static_cast<uint32_t>(uniform_table.size()));
+            uniform_table.push_back(std::move(info));
+        }
+
+        GLint num_blocks = 0;
+        glGetProgramiv(m_glid, GL_ACTIVE_UNIFORM_BLOCKS, &num_blocks);
+        glGetProgramiv(m_glid, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &max_length);
+
+        name.assign(static_cast<size_t>(std::max(max_length, 1)), '\0');
+
+        for (GLint index = 0; index < num_blocks; index++) {
+            GLsizei length = 0;
+            glGetActiveUniformBlockName(m_glid, static_cast<GLuint>(index), max_length, &length, name.data());
+            uniform_blocks.push_back(name.substr(0, length));
+        }
+
+        // the application thread may be setting uniforms while the render thread finishes the program
+        std::lock_guard lock(m_uniform_mutex);
+
+        m_uniform_table = std::move(uniform_table);
+        m_uniform_slots = std::move(uniform_slots);
+        m_uniform_blocks = std::move(uniform_blocks);
+        m_missing_uniforms.clear();
+
+        // a relinked program holds none of the values
+        m_resident.assign(m_uniform_table.size(), std::nullopt);
+        m_dirty.clear();
+        m_dirty_flags.assign(m_uniform_table.size(), 0);
+        m_resident_stored = false;
+        m_block_generation = 0;
+
+        // uniforms set before linking are checked against the new program
+        for (const auto& [uniform, value] : m_uniforms) {
+            if (!m_uniform_slots.contains(uniform) && m_missing_uniforms.insert(uniform).second)
+                BSK_WARNING("Warning: Uniform '" + uniform + "' not found in shader.");
+        }
+
+        m_pending = false;
     }
 
-    void Shader::m_apply_uniforms() const {
+    void Shader::m_apply_uniforms(const Uniforms& uniforms) const {
+        for (const auto& [name, value] : uniforms) {
+            auto slot = m_uniform_slots.find(name);
+
+            // missing uniforms were warned about when they were set
+            if (slot != m_uniform_slots.end())
+                m_apply_uniform(slot->second, value);
+        }
+    }
+
+    void Shader::m_apply_uniform(uint32_t slot, const UniformValue& value) const {
+        std::optional<UniformValue>& resident = m_resident[slot];
+
+        // the program already holds the value
+        if (resident && same_value(*resident, value))
+            return;
+
+        resident = value;
+        GLint location = m_uniform_table[slot].location;
+
         static constexpr auto apply_uniform =
-            [](uint32_t id, const std::string& name, const UniformValue& value) {
-                GLint location = glGetUniformLocation(id, name.c_str());
-                if (location == -1) {
-                    BSK_WARNING("Warning: Uniform '" + name + "' not found in shader.");
-                    return;
-                }
-            
+            [](GLint location, const UniformValue& value) {
                 std::visit([location](auto&& v) {
                     using T = std::decay_t<decltype(v)>;
             
@@ -335,9 +646,24 @@ namespace bskgl {
             );
         };
 
-        for (const auto& [name, value] : m_uniforms)
-            apply_uniform(m_glid, name, value);
+        apply_uniform(location, value);
+    }
+
+    void Shader::m_bind_uniform_blocks() const {
+        const UniformBlockRegistry* registry = UniformBlockRegistry::active();
+
+        // the binding points only change when blocks are registered or unregistered
+        if (!registry || m_uniform_blocks.empty() || m_block_generation == registry->generation())
+            return;
+
+        for (size_t index = 0; index < m_uniform_blocks.size(); index++) {
+            uint32_t binding = registry->binding(m_uniform_blocks[index]);
+
+            if (binding != UniformBlockRegistry::none)
+                glUniformBlockBinding(m_glid, static_cast<GLuint>(index), binding);
+        }
+
+        m_block_generation = registry->generation();
     }
-    
 
-}
\ No newline at end of file
+}
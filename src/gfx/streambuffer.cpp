@@ -0,0 +1,183 @@
+#include <glad/glad.h>
+
+#include <gfx/streambuffer.h>
+#include <context/gl_state_cache.h>
+#include <core/error_handler.h>
+
+namespace bskgl {
+
+    static constexpr GLbitfield stream_flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    StreamBuffer::StreamBuffer(UUID uuid, size_t region_size, uint32_t num_regions)
+        :
+        m_uuid(uuid),
+        m_glid(0),
+        m_region_size(region_size),
+        m_num_regions(num_regions),
+        m_region(0),
+        m_head(0),
+        m_mapped(nullptr),
+        m_fences(num_regions, nullptr) {
+        BSK_VERIFY(region_size != 0 && num_regions != 0, "Stream buffer needs atleast one non empty region.");
+
+        glCreateBuffers(1, &m_glid);
+
+        glNamedBufferStorage(m_glid, m_region_size * m_num_regions, nullptr, stream_flags);
+        m_mapped = static_cast<uint8_t*>(glMapNamedBufferRange(m_glid, 0, m_region_size * m_num_regions, stream_flags));
+
+        if (!m_mapped)
+            BSK_ERROR("Failed to map stream buffer.");
+    }
+
+    StreamBuffer::StreamBuffer(StreamBuffer&& other) noexcept
+        :
+        m_uuid(other.m_uuid),
+        m_glid(other.m_glid),
+        m_region_size(other.m_region_size),
+        m_num_regions(other.m_num_regions),
+        m_region(other.m_region),
+        m_head(other.m_head),
+        m_mapped(other.m_mapped),
+        m_fences(std::move(other.m_fences)) {
+        other.m_glid = 0;
+        other.m_mapped = nullptr;
+    }
+
+    StreamBuffer& StreamBuffer::operator=(StreamBuffer&& other) noexcept {
+        if (this == &other)
+            return *this;
+
+        m_release();
+
+        m_uuid = other.m_uuid;
+        m_glid = other.m_glid;
+        m_region_size = other.m_region_size;
+        m_num_regions = other.m_num_regions;
+        m_region = other.m_region;
+        m_head = other.m_head;
+        m_mapped = other.m_mapped;
+        m_fences = std::move(other.m_fences);
+
+        other.m_glid = 0;
+        other.m_mapped = nullptr;
+
+        return *this;
+    }
+
+    StreamBuffer::~StreamBuffer() {
+        m_release();
+    }
+
+    UUID StreamBuffer::uuid() const {
+        return m_uuid;
+    }
+
+    uint32_t StreamBuffer::gl_id() const {
+        return m_glid;
+    }
+
+    size_t StreamBuffer::region_size() const {
+        return m_region_size;
+    }
+
+    uint32_t StreamBuffer::num_regions() const {
+        return m_num_regions;
+    }
+
+    uint32_t StreamBuffer::current_region() const {
+        return m_region;
+    }
+
+    StreamBuffer::Allocation StreamBuffer::allocate(size_t size, size_t alignment) {
+        if (!m_mapped || size > m_region_size) {
+            BSK_ERROR("Stream buffer allocation is larger than a region.");
+            return Allocation();
+        }
+
+        auto align_up = [alignment](size_t offset) { return (offset + alignment - 1) / alignment * alignment; };
+
+        size_t region_start = m_region * m_region_size;
+        size_t offset = align_up(region_start + m_head);
+
+        // move to the next region if the allocation doesn't fit
+        if (offset + size > region_start + m_region_size) {
+            this->next_region();
+
+            region_start = m_region * m_region_size;
+            offset = align_up(region_start);
+
+            if (offset + size > region_start + m_region_size) {
+                BSK_ERROR("Stream buffer allocation doesn't fit in an aligned region.");
+                return Allocation();
+            }
+        }
+
+        m_head = offset + size - region_start;
+
+        return { m_mapped + offset, offset };
+    }
+
+    void StreamBuffer::next_region() {
+        m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        m_region = (m_region + 1) % m_num_regions;
+        m_head = 0;
+
+        m_wait(m_region);
+    }
+
+    void StreamBuffer::bind() const {
+        GLStateCache::active().bind_buffer(GL_ARRAY_BUFFER, m_glid);
+    }
+
+    void StreamBuffer::unbind() {
+        GLStateCache::active().bind_buffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void StreamBuffer::m_wait(uint32_t region) {
+        GLsync fence = static_cast<GLsync>(m_fences[region]);
+        if (!fence)
+            return;
+
+        // flush on the first wait so the fence is guaranteed to signal
+        GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+
+        while (true) {
+            GLenum result = glClientWaitSync(fence, flags, 1000000);
+
+            if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+                break;
+
+            if (result == GL_WAIT_FAILED) {
+                BSK_ERROR("Failed to wait for stream buffer fence.");
+                break;
+            }
+
+            flags = 0;
+        }
+
+        glDeleteSync(fence);
+        m_fences[region] = nullptr;
+    }
+
+    void StreamBuffer::m_release() {
+        for (void* fence : m_fences) {
+            if (fence)
+                glDeleteSync(static_cast<GLsync>(fence));
+        }
+        m_fences.clear();
+
+        if (m_glid == 0)
+            return;
+
+        if (m_mapped) {
+            glUnmapNamedBuffer(m_glid);
+            m_mapped = nullptr;
+        }
+
+        glDeleteBuffers(1, &m_glid);
+        GLStateCache::active().on_buffer_deleted(m_glid);
+        m_glid = 0;
+    }
+
+}
@@ -1,10 +1,53 @@
 #include <glad/glad.h>
 
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
 #include <gfx/texture/texture2d.h>
 #include <core/convert_values.h>
+#include <context/gl_state_cache.h>
+#include <core/error_handler.h>
 
 namespace bskgl {
 
+    // immutable storage needs a sized format
+    static GLenum sized_internal_format(TextureBase::InternalFormat format) {
+        switch (format) {
+            case TextureBase::InternalFormat::Red:
+                return GL_R8;
+            case TextureBase::InternalFormat::RG:
+                return GL_RG8;
+            case TextureBase::InternalFormat::RGB:
+                return GL_RGB8;
+            case TextureBase::InternalFormat::Depth:
+                return GL_DEPTH_COMPONENT24;
+            case TextureBase::InternalFormat::DepthStencil:
+                return GL_DEPTH24_STENCIL8;
+            default:
+                return GL_RGBA8;
+        }
+    }
+
+    // reloads released pixels from their file, fails if the file is gone or no longer matches the uploaded size
+    static bool reload_sprite(Sprite& sprite, const std::filesystem::path& source) {
+        try {
+            Sprite loaded(source);
+
+            if (loaded.width() != sprite.width() || loaded.height() != sprite.height() || loaded.channels() != sprite.channels()) {
+                BSK_WARNING("Texture file " + source.string() + " changed since it was uploaded, reading the pixels back instead.");
+                return false;
+            }
+
+            sprite = std::move(loaded);
+        } catch (const std::runtime_error&) {
+            BSK_WARNING("Texture file " + source.string() + " couldn't be reloaded, reading the pixels back instead.");
+            return false;
+        }
+
+        return true;
+    }
+
     Texture2D::Texture2D(
         UUID uuid, const std::filesystem::path& texfile,
         TextureBase::MinFilter min_filter,
@@ -15,11 +58,12 @@ namespace bskgl {
         :
         m_uuid(uuid),
         m_sprite(texfile),
+        m_source(texfile),
         m_min_filter(min_filter),
         m_mag_filter(mag_filter),
         m_wrap_mode_s(wrap_mode_s),
         m_wrap_mode_t(wrap_mode_t) {
-        glGenTextures(1, &m_glid);
+        glCreateTextures(GL_TEXTURE_2D, 1, &m_glid);
         this->sync();
     }
 
@@ -37,21 +81,45 @@ namespace bskgl {
         m_mag_filter(mag_filter),
         m_wrap_mode_s(wrap_mode_s),
         m_wrap_mode_t(wrap_mode_t) {
-        glGenTextures(1, &m_glid);
+        glCreateTextures(GL_TEXTURE_2D, 1, &m_glid);
         this->sync();
     }
 
     Texture2D::Texture2D(Texture2D&& other) noexcept {
+        m_uuid = other.m_uuid;
         m_glid = other.m_glid;
         other.m_glid = 0;
         m_sprite = std::move(other.m_sprite);
+        m_source = std::move(other.m_source);
+        m_residency = other.m_residency;
+        m_released = std::move(other.m_released);
+        m_internal_format = other.m_internal_format;
+        m_format = other.m_format;
+        m_storage_width = other.m_storage_width;
+        m_storage_height = other.m_storage_height;
+        m_min_filter = other.m_min_filter;
+        m_mag_filter = other.m_mag_filter;
+        m_wrap_mode_s = other.m_wrap_mode_s;
+        m_wrap_mode_t = other.m_wrap_mode_t;
         this->sync();
     }
 
     Texture2D& Texture2D::operator=(Texture2D&& other) noexcept {
+        m_uuid = other.m_uuid;
         m_glid = other.m_glid;
         other.m_glid = 0;
         m_sprite = std::move(other.m_sprite);
+        m_source = std::move(other.m_source);
+        m_residency = other.m_residency;
+        m_released = std::move(other.m_released);
+        m_internal_format = other.m_internal_format;
+        m_format = other.m_format;
+        m_storage_width = other.m_storage_width;
+        m_storage_height = other.m_storage_height;
+        m_min_filter = other.m_min_filter;
+        m_mag_filter = other.m_mag_filter;
+        m_wrap_mode_s = other.m_wrap_mode_s;
+        m_wrap_mode_t = other.m_wrap_mode_t;
         this->sync();
 
         return *this;   
@@ -59,6 +127,11 @@ namespace bskgl {
 
     Texture2D::~Texture2D() {
         glDeleteTextures(1, &m_glid);
+        GLStateCache::active().on_texture_deleted(m_glid);
+    }
+
+    UUID Texture2D::uuid() const {
+        return m_uuid;
     }
 
     uint32_t Texture2D::gl_id() const {
@@ -106,14 +179,29 @@ namespace bskgl {
     }
 
     const Sprite& Texture2D::sprite() const {
+        m_restore();
         return m_sprite;
     }
 
+    Residency Texture2D::residency() const {
+        return m_residency;
+    }
+
+    Texture2D& Texture2D::set_residency(Residency residency) {
+        m_residency = residency;
+
+        if (m_residency == Residency::Shadowed)
+            m_restore();
+        else
+            m_release();
+
+        return *this;
+    }
+
     Texture2D& Texture2D::set_min_filter(TextureBase::MinFilter min_filter) {
         m_min_filter = min_filter;
         
-        this->bind();
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, opengl::convert(min_filter));
+        glTextureParameteri(m_glid, GL_TEXTURE_MIN_FILTER, opengl::convert(min_filter));
         
         return *this;
     }
@@ -121,8 +209,7 @@ namespace bskgl {
     Texture2D& Texture2D::set_mag_filter(TextureBase::MagFilter mag_filter) {
         m_mag_filter = mag_filter;
         
-        this->bind();
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, opengl::convert(mag_filter));
+        glTextureParameteri(m_glid, GL_TEXTURE_MAG_FILTER, opengl::convert(mag_filter));
         
         return *this;
     }
@@ -130,8 +217,7 @@ namespace bskgl {
     Texture2D& Texture2D::set_wrap_mode_s(TextureBase::WrapMode wrap_mode) {
         m_wrap_mode_s = wrap_mode;
         
-        this->bind();
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, opengl::convert(wrap_mode));	
+        glTextureParameteri(m_glid, GL_TEXTURE_WRAP_S, opengl::convert(wrap_mode));
         
         return *this;
     }
@@ -139,13 +225,16 @@ namespace bskgl {
     Texture2D& Texture2D::set_wrap_mode_t(TextureBase::WrapMode wrap_mode) {
         m_wrap_mode_t = wrap_mode;
         
-        this->bind();
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, opengl::convert(wrap_mode));
+        glTextureParameteri(m_glid, GL_TEXTURE_WRAP_T, opengl::convert(wrap_mode));
         
         return *this;
     }
 
     Texture2D& Texture2D::read_from(const std::filesystem::path& _texfile) {
+        // the released pixels are replaced, there's nothing to reload
+        m_released.discard();
+
+        m_source = _texfile;
         m_sprite.read_from(_texfile);
         this->sync();
         return *this;
@@ -153,47 +242,118 @@ namespace bskgl {
 
     void Texture2D::bind(int32_t _tex_unit) const {
         if (_tex_unit == -1)
-            glBindTextureUnit(this->default_texture_unit, m_glid);
+            GLStateCache::active().bind_texture_unit(this->default_texture_unit, m_glid);
         else
-            glBindTextureUnit(_tex_unit, m_glid);
+            GLStateCache::active().bind_texture_unit(_tex_unit, m_glid);
+    }
+
+    void Texture2D::bind() const {
+        this->bind(-1);
     }
 
     Texture2D& Texture2D::sync() {
+        // released pixels haven't been modified since they were uploaded
+        if (m_released.released())
+            return *this;
+
+        TextureBase::InternalFormat internal_format;
+
         switch (m_sprite.channels()) {
             case 1:
-                m_internal_format = TextureBase::InternalFormat::Red;
+                internal_format = TextureBase::InternalFormat::Red;
                 m_format = TextureBase::Format::Red;
                 break;
             case 3:
-                m_internal_format = TextureBase::InternalFormat::RGB;
+                internal_format = TextureBase::InternalFormat::RGB;
                 m_format = TextureBase::Format::RGB;
                 break;
             case 4:
-                m_internal_format = TextureBase::InternalFormat::RGBA;
+                internal_format = TextureBase::InternalFormat::RGBA;
                 m_format = TextureBase::Format::RGBA;
                 break;
             default:
                 throw std::runtime_error("Unsupported number of channels in texture.");
         }
 
-        glBindTexture(GL_TEXTURE_2D, m_glid);
+        uint32_t width = m_sprite.width();
+        uint32_t height = m_sprite.height();
+
+        // immutable storage can't be resized, replace the texture object when the image changes shape
+        if (m_storage_width != 0 && (width != m_storage_width || height != m_storage_height || internal_format != m_internal_format)) {
+            glDeleteTextures(1, &m_glid);
+            GLStateCache::active().on_texture_deleted(m_glid);
+
+            glCreateTextures(GL_TEXTURE_2D, 1, &m_glid);
+            m_storage_width = 0;
+            m_storage_height = 0;
+        }
+
+        m_internal_format = internal_format;
 
-        glTexImage2D(
-            GL_TEXTURE_2D, 
-            0, 
-            opengl::convert(m_internal_format), 
-            m_sprite.width(), m_sprite.height(), 0, 
-            opengl::convert(m_format), 
-            opengl::convert(Texture2D::tex_data_type), 
-            m_sprite.data());
-        glGenerateMipmap(GL_TEXTURE_2D);
+        if (m_storage_width == 0 && width != 0 && height != 0) {
+            // a level for every halving down to 1x1
+            GLsizei levels = static_cast<GLsizei>(std::bit_width(std::max(width, height)));
+            glTextureStorage2D(m_glid, levels, sized_internal_format(m_internal_format), width, height);
+
+            m_storage_width = width;
+            m_storage_height = height;
+        }
+
+        if (m_storage_width != 0) {
+            glTextureSubImage2D(
+                m_glid,
+                0,
+                0, 0,
+                width, height,
+                opengl::convert(m_format),
+                opengl::convert(Texture2D::tex_data_type),
+                m_sprite.data());
+            glGenerateTextureMipmap(m_glid);
+        }
 
         this->set_min_filter(m_min_filter)
             .set_mag_filter(m_mag_filter)
             .set_wrap_mode_s(m_wrap_mode_s)
             .set_wrap_mode_t(m_wrap_mode_t);
 
+        if (m_residency == Residency::GPUOnly)
+            m_release();
+
         return *this;
     }
 
+    void Texture2D::m_release() {
+        if (m_released.released() || !m_sprite.is_valid())
+            return;
+
+        m_released.release(static_cast<size_t>(m_sprite.width()) * m_sprite.height() * m_sprite.channels());
+        m_sprite.release();
+    }
+
+    void Texture2D::m_restore() const {
+        if (!m_released.released())
+            return;
+
+        // the file is only trusted while it still holds what was uploaded
+        if (!m_source.empty() && reload_sprite(m_sprite, m_source)) {
+            m_released.restored();
+            return;
+        }
+
+        if (!m_released.can_read_back("Released pixels"))
+            return;
+
+        Sprite sprite(m_sprite.width(), m_sprite.height(), m_sprite.channels());
+
+        // rows of three channel textures aren't four byte aligned
+        GLsizei size = static_cast<GLsizei>(m_released.bytes());
+
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glGetTextureImage(m_glid, 0, opengl::convert(m_format), opengl::convert(Texture2D::tex_data_type), size, sprite.data());
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+        m_sprite = std::move(sprite);
+        m_released.restored();
+    }
+
 }
\ No newline at end of file
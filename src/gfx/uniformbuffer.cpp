@@ -0,0 +1,81 @@
+#include <glad/glad.h>
+
+#include <gfx/uniformbuffer.h>
+#include <context/gl_state_cache.h>
+#include <core/error_handler.h>
+
+namespace bskgl {
+
+    UniformBuffer::UniformBuffer(UUID uuid, size_t size)
+        :
+        m_uuid(uuid),
+        m_glid(0),
+        m_size(size) {
+        BSK_VERIFY(size != 0, "Uniform buffer can't be empty.");
+
+        glCreateBuffers(1, &m_glid);
+        glNamedBufferStorage(m_glid, m_size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+    }
+
+    UniformBuffer::UniformBuffer(UniformBuffer&& other) noexcept
+        :
+        m_uuid(other.m_uuid),
+        m_glid(other.m_glid),
+        m_size(other.m_size) {
+        other.m_glid = 0;
+    }
+
+    UniformBuffer& UniformBuffer::operator=(UniformBuffer&& other) noexcept {
+        if (this == &other)
+            return *this;
+
+        m_release();
+
+        m_uuid = other.m_uuid;
+        m_glid = other.m_glid;
+        m_size = other.m_size;
+
+        other.m_glid = 0;
+
+        return *this;
+    }
+
+    UniformBuffer::~UniformBuffer() {
+        m_release();
+    }
+
+    UUID UniformBuffer::uuid() const {
+        return m_uuid;
+    }
+
+    uint32_t UniformBuffer::gl_id() const {
+        return m_glid;
+    }
+
+    size_t UniformBuffer::size() const {
+        return m_size;
+    }
+
+    void UniformBuffer::update(const void* data, size_t size, size_t offset) {
+        if (offset + size > m_size) {
+            BSK_ERROR("Uniform buffer update is out of range.");
+            return;
+        }
+
+        glNamedBufferSubData(m_glid, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+    }
+
+    void UniformBuffer::bind(uint32_t binding) const {
+        GLStateCache::active().bind_buffer_range(GL_UNIFORM_BUFFER, binding, m_glid, 0, m_size);
+    }
+
+    void UniformBuffer::m_release() {
+        if (m_glid == 0)
+            return;
+
+        glDeleteBuffers(1, &m_glid);
+        GLStateCache::active().on_buffer_deleted(m_glid);
+        m_glid = 0;
+    }
+
+}
@@ -0,0 +1,87 @@
+#include <gfx/vertex_data.h>
+
+namespace bskgl {
+
+    VertexData::VertexData()
+        :
+        m_layout(),
+        m_owner(),
+        m_data(nullptr),
+        m_size(0) { }
+
+    VertexData::VertexData(VertexLayout layout, std::vector<uint8_t> bytes)
+        :
+        m_layout(std::move(layout)) {
+        BSK_VERIFY(m_layout.stride() != 0 && bytes.size() % m_layout.stride() == 0, "Vertex bytes aren't a multiple of the layout stride.");
+
+        size_t size = bytes.size() / m_layout.stride();
+        auto owner = std::make_shared<std::vector<uint8_t>>(std::move(bytes));
+        m_adopt(owner, owner->data(), size);
+    }
+
+    VertexData::VertexData(VertexData&& other) noexcept
+        :
+        m_layout(std::move(other.m_layout)),
+        m_owner(std::move(other.m_owner)),
+        m_data(other.m_data),
+        m_size(other.m_size) {
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+
+    VertexData& VertexData::operator=(VertexData&& other) noexcept {
+        if (this == &other)
+            return *this;
+
+        m_layout = std::move(other.m_layout);
+        m_owner = std::move(other.m_owner);
+        m_data = other.m_data;
+        m_size = other.m_size;
+
+        other.m_data = nullptr;
+        other.m_size = 0;
+
+        return *this;
+    }
+
+    const VertexLayout& VertexData::layout() const {
+        return m_layout;
+    }
+
+    size_t VertexData::size() const {
+        return m_size;
+    }
+
+    size_t VertexData::size_bytes() const {
+        return m_size * m_layout.stride();
+    }
+
+    uint8_t* VertexData::data() {
+        return m_data;
+    }
+
+    const uint8_t* VertexData::data() const {
+        return m_data;
+    }
+
+    bool VertexData::is_resident() const {
+        return m_data != nullptr || m_size == 0;
+    }
+
+    void VertexData::release() {
+        m_owner.reset();
+        m_data = nullptr;
+    }
+
+    void VertexData::reallocate() {
+        auto owner = std::make_shared<std::vector<uint8_t>>(this->size_bytes());
+        m_adopt(owner, owner->data(), m_size);
+    }
+
+    void VertexData::m_adopt(std::shared_ptr<void> owner, uint8_t* data, size_t size) {
+        m_owner = std::move(owner);
+        m_data = data;
+        m_size = size;
+    }
+
+}
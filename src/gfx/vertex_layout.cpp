@@ -0,0 +1,156 @@
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <glm/gtc/packing.hpp>
+
+#include <gfx/vertex_layout.h>
+
+namespace bskgl {
+
+    static GLenum gl_attribute_type(VertexAttributeType type) {
+        switch (type) {
+            case VertexAttributeType::HalfFloat:
+                return GL_HALF_FLOAT;
+            case VertexAttributeType::Byte:
+                return GL_BYTE;
+            case VertexAttributeType::UnsignedByte:
+                return GL_UNSIGNED_BYTE;
+            case VertexAttributeType::Short:
+                return GL_SHORT;
+            case VertexAttributeType::UnsignedShort:
+                return GL_UNSIGNED_SHORT;
+            case VertexAttributeType::Int:
+                return GL_INT;
+            case VertexAttributeType::UnsignedInt:
+                return GL_UNSIGNED_INT;
+            default:
+                return GL_FLOAT;
+        }
+    }
+
+    // decodes one component the way the vertex fetch would
+    template <typename T>
+    static float decode_component(const uint8_t* data, bool normalized) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+
+        if constexpr (std::is_integral_v<T>) {
+            if (normalized) {
+                // signed values map to [-1, 1], the most negative value clamps to -1
+                if constexpr (std::is_signed_v<T>)
+                    return std::max(static_cast<float>(value) / static_cast<float>(std::numeric_limits<T>::max()), -1.0f);
+                else
+                    return static_cast<float>(value) / static_cast<float>(std::numeric_limits<T>::max());
+            }
+        }
+
+        return static_cast<float>(value);
+    }
+
+    VertexLayout::VertexLayout()
+        :
+        m_attributes(),
+        m_stride(0) { }
+
+    VertexLayout::VertexLayout(std::vector<VertexAttribute> attributes, uint32_t stride)
+        :
+        m_attributes(std::move(attributes)),
+        m_stride(stride) { }
+
+    const std::vector<VertexAttribute>& VertexLayout::attributes() const {
+        return m_attributes;
+    }
+
+    uint32_t VertexLayout::stride() const {
+        return m_stride;
+    }
+
+    const VertexAttribute* VertexLayout::find(uint32_t location) const {
+        for (const VertexAttribute& attribute : m_attributes) {
+            if (attribute.location == location)
+                return &attribute;
+        }
+
+        return nullptr;
+    }
+
+    glm::vec3 VertexLayout::position(const uint8_t* vertex) const {
+        glm::vec3 position = glm::vec3(0.0f);
+
+        const VertexAttribute* attribute = this->find(0);
+        if (!attribute)
+            return position;
+
+        uint32_t size = vertex_attribute_type_size(attribute->type);
+        const uint8_t* data = vertex + attribute->offset;
+
+        for (uint32_t component = 0; component < std::min(attribute->components, 3u); component++, data += size) {
+            switch (attribute->type) {
+                case VertexAttributeType::Float:
+                    position[component] = decode_component<float>(data, false);
+                    break;
+                case VertexAttributeType::HalfFloat: {
+                    uint16_t half;
+                    std::memcpy(&half, data, sizeof(half));
+                    position[component] = glm::unpackHalf1x16(half);
+                    break;
+                }
+                case VertexAttributeType::Byte:
+                    position[component] = decode_component<int8_t>(data, attribute->normalized);
+                    break;
+                case VertexAttributeType::UnsignedByte:
+                    position[component] = decode_component<uint8_t>(data, attribute->normalized);
+                    break;
+                case VertexAttributeType::Short:
+                    position[component] = decode_component<int16_t>(data, attribute->normalized);
+                    break;
+                case VertexAttributeType::UnsignedShort:
+                    position[component] = decode_component<uint16_t>(data, attribute->normalized);
+                    break;
+                case VertexAttributeType::Int:
+                    position[component] = decode_component<int32_t>(data, attribute->normalized);
+                    break;
+                case VertexAttributeType::UnsignedInt:
+                    position[component] = decode_component<uint32_t>(data, attribute->normalized);
+                    break;
+            }
+        }
+
+        return position;
+    }
+
+    void VertexLayout::apply(uint32_t vertexarray, uint32_t binding) const {
+        for (const VertexAttribute& attribute : m_attributes) {
+            glEnableVertexArrayAttrib(vertexarray, attribute.location);
+
+            // the float format converts integers, ivec and uvec inputs would read garbage
+            if (attribute.integer && vertex_attribute_type_is_integer(attribute.type) && !attribute.normalized) {
+                glVertexArrayAttribIFormat(
+                    vertexarray,
+                    attribute.location,
+                    attribute.components,
+                    gl_attribute_type(attribute.type),
+                    attribute.offset);
+            } else {
+                glVertexArrayAttribFormat(
+                    vertexarray,
+                    attribute.location,
+                    attribute.components,
+                    gl_attribute_type(attribute.type),
+                    attribute.normalized ? GL_TRUE : GL_FALSE,
+                    attribute.offset);
+            }
+
+            glVertexArrayAttribBinding(vertexarray, attribute.location, binding);
+        }
+    }
+
+    void VertexLayout::disable(uint32_t vertexarray) const {
+        for (const VertexAttribute& attribute : m_attributes)
+            glDisableVertexArrayAttrib(vertexarray, attribute.location);
+    }
+
+}
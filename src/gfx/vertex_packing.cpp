@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include <gfx/vertex_packing.h>
+
+#if defined(BSK_SIMD_SSE2)
+    #include <emmintrin.h>
+#endif
+
+#if defined(BSK_SIMD_F16C)
+    #include <immintrin.h>
+#endif
+
+namespace bskgl {
+
+    // smallest sum of absolute components an octahedral encode divides by, zero vectors encode to +z
+    static constexpr float k_octahedral_min_sum = 1e-30f;
+
+    // clamps like maxps / minps, a NaN ends up as -1 on both paths
+    static float clamp_snorm(float value) {
+        value = value > -1.0f ? value : -1.0f;
+        return value < 1.0f ? value : 1.0f;
+    }
+
+    static int16_t quantize_snorm16(float value) {
+        // nearbyint rounds to nearest even, like cvtps2dq under the default rounding mode
+        return static_cast<int16_t>(std::nearbyint(clamp_snorm(value) * 32767.0f));
+    }
+
+    // round to nearest even float to half, matches vcvtps2ph for every non NaN input
+    static uint16_t float_to_half(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        uint32_t sign = (bits >> 16) & 0x8000u;
+        bits &= 0x7FFFFFFFu;
+
+        // too large for a half, or inf / NaN
+        if (bits >= 0x47800000u)
+            return static_cast<uint16_t>(sign | (bits > 0x7F800000u ? 0x7E00u : 0x7C00u));
+
+        // half subnormals, adding 0.5 lines the mantissa up with the half's and lets the FPU round
+        if (bits < 0x38800000u) {
+            float shifted;
+            std::memcpy(&shifted, &bits, sizeof(shifted));
+            shifted += 0.5f;
+            std::memcpy(&bits, &shifted, sizeof(bits));
+            return static_cast<uint16_t>(sign | (bits - 0x3F000000u));
+        }
+
+        // rebias the exponent and round the dropped 13 mantissa bits to even
+        uint32_t odd = (bits >> 13) & 1u;
+        bits += 0xC8000FFFu + odd;
+        return static_cast<uint16_t>(sign | (bits >> 13));
+    }
+
+    static void pack_scalar(const Vertex& vertex, PackedVertex& packed, const glm::vec3& offset, const glm::vec3& inv_scale) {
+        glm::vec3 position = (vertex.position - offset) * inv_scale;
+
+        packed.position[0] = quantize_snorm16(position.x);
+        packed.position[1] = quantize_snorm16(position.y);
+        packed.position[2] = quantize_snorm16(position.z);
+        packed.position[3] = 32767;
+
+        VertexPacker::encode_octahedral(vertex.normal, packed.normal);
+
+        packed.tex_coords[0] = float_to_half(vertex.tex_coords.x);
+        packed.tex_coords[1] = float_to_half(vertex.tex_coords.y);
+    }
+
+#if defined(BSK_SIMD_SSE2)
+    static __m128i quantize_snorm16(__m128 value) {
+        const __m128 one = _mm_set1_ps(1.0f);
+        value = _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(-1.0f)), one);
+        return _mm_cvtps_epi32(_mm_mul_ps(value, _mm_set1_ps(32767.0f)));
+    }
+
+    // packs four vertices, the attributes are transposed so every lane handles one vertex
+    static void pack_sse2(const Vertex* vertices, PackedVertex* packed, const glm::vec3& offset, const glm::vec3& inv_scale) {
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 sign_mask = _mm_set1_ps(-0.0f);
+
+        alignas(16) int32_t position[3][4];
+        alignas(16) int32_t normal[2][4];
+
+        for (int axis = 0; axis < 3; axis++) {
+            __m128 value = _mm_setr_ps(vertices[0].position[axis], vertices[1].position[axis], vertices[2].position[axis], vertices[3].position[axis]);
+            value = _mm_mul_ps(_mm_sub_ps(value, _mm_set1_ps(offset[axis])), _mm_set1_ps(inv_scale[axis]));
+            _mm_store_si128(reinterpret_cast<__m128i*>(position[axis]), quantize_snorm16(value));
+        }
+
+        __m128 nx = _mm_setr_ps(vertices[0].normal.x, vertices[1].normal.x, vertices[2].normal.x, vertices[3].normal.x);
+        __m128 ny = _mm_setr_ps(vertices[0].normal.y, vertices[1].normal.y, vertices[2].normal.y, vertices[3].normal.y);
+        __m128 nz = _mm_setr_ps(vertices[0].normal.z, vertices[1].normal.z, vertices[2].normal.z, vertices[3].normal.z);
+
+        // project onto the octahedron |x| + |y| + |z| = 1
+        __m128 sum = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(sign_mask, nx), _mm_andnot_ps(sign_mask, ny)), _mm_andnot_ps(sign_mask, nz));
+        __m128 inv_sum = _mm_div_ps(one, _mm_max_ps(sum, _mm_set1_ps(k_octahedral_min_sum)));
+        nx = _mm_mul_ps(nx, inv_sum);
+        ny = _mm_mul_ps(ny, inv_sum);
+        nz = _mm_mul_ps(nz, inv_sum);
+
+        // fold the lower hemisphere over the diagonals
+        __m128 sign_x = _mm_or_ps(_mm_and_ps(nx, sign_mask), one);
+        __m128 sign_y = _mm_or_ps(_mm_and_ps(ny, sign_mask), one);
+        __m128 fold_x = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(sign_mask, ny)), sign_x);
+        __m128 fold_y = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(sign_mask, nx)), sign_y);
+        __m128 lower = _mm_cmplt_ps(nz, _mm_setzero_ps());
+        nx = _mm_or_ps(_mm_and_ps(lower, fold_x), _mm_andnot_ps(lower, nx));
+        ny = _mm_or_ps(_mm_and_ps(lower, fold_y), _mm_andnot_ps(lower, ny));
+
+        _mm_store_si128(reinterpret_cast<__m128i*>(normal[0]), quantize_snorm16(nx));
+        _mm_store_si128(reinterpret_cast<__m128i*>(normal[1]), quantize_snorm16(ny));
+
+        alignas(16) uint16_t tex_coords[8];
+#if defined(BSK_SIMD_F16C)
+        __m128 uv01 = _mm_setr_ps(vertices[0].tex_coords.x, vertices[0].tex_coords.y, vertices[1].tex_coords.x, vertices[1].tex_coords.y);
+        __m128 uv23 = _mm_setr_ps(vertices[2].tex_coords.x, vertices[2].tex_coords.y, vertices[3].tex_coords.x, vertices[3].tex_coords.y);
+        __m128i halves = _mm_unpacklo_epi64(
+            _mm_cvtps_ph(uv01, _MM_FROUND_TO_NEAREST_INT),
+            _mm_cvtps_ph(uv23, _MM_FROUND_TO_NEAREST_INT));
+        _mm_store_si128(reinterpret_cast<__m128i*>(tex_coords), halves);
+#else
+        for (int vertex = 0; vertex < 4; vertex++) {
+            tex_coords[vertex * 2] = float_to_half(vertices[vertex].tex_coords.x);
+            tex_coords[vertex * 2 + 1] = float_to_half(vertices[vertex].tex_coords.y);
+        }
+#endif
+
+        for (int vertex = 0; vertex < 4; vertex++) {
+            packed[vertex].position[0] = static_cast<int16_t>(position[0][vertex]);
+            packed[vertex].position[1] = static_cast<int16_t>(position[1][vertex]);
+            packed[vertex].position[2] = static_cast<int16_t>(position[2][vertex]);
+            packed[vertex].position[3] = 32767;
+            packed[vertex].normal[0] = static_cast<int16_t>(normal[0][vertex]);
+            packed[vertex].normal[1] = static_cast<int16_t>(normal[1][vertex]);
+            packed[vertex].tex_coords[0] = tex_coords[vertex * 2];
+            packed[vertex].tex_coords[1] = tex_coords[vertex * 2 + 1];
+        }
+    }
+#endif
+
+    Quantization Quantization::from_bounds(const Bounds& bounds) {
+        Quantization quantization;
+        quantization.offset = (bounds.min + bounds.max) * 0.5f;
+        quantization.scale = (bounds.max - bounds.min) * 0.5f;
+
+        // a flat axis would divide by zero, every position on it quantizes to zero anyway
+        for (int axis = 0; axis < 3; axis++) {
+            if (quantization.scale[axis] <= 0.0f)
+                quantization.scale[axis] = 1.0f;
+        }
+
+        return quantization;
+    }
+
+    glm::mat4 Quantization::matrix() const {
+        return glm::scale(glm::translate(glm::mat4(1.0f), offset), scale);
+    }
+
+    Quantization VertexPacker::quantization(std::span<const Vertex> vertices) {
+        static const VertexLayout layout = Vertex::Format::layout();
+        return Quantization::from_bounds(Bounds::from_vertices(reinterpret_cast<const uint8_t*>(vertices.data()), vertices.size(), layout));
+    }
+
+    std::vector<PackedVertex> VertexPacker::pack(std::span<const Vertex> vertices, const Quantization& quantization) {
+        std::vector<PackedVertex> packed(vertices.size());
+        glm::vec3 inv_scale = 1.0f / quantization.scale;
+
+        size_t vertex = 0;
+
+#if defined(BSK_SIMD_SSE2)
+        for (; vertex + 4 <= vertices.size(); vertex += 4)
+            pack_sse2(vertices.data() + vertex, packed.data() + vertex, quantization.offset, inv_scale);
+#endif
+
+        for (; vertex < vertices.size(); vertex++)
+            pack_scalar(vertices[vertex], packed[vertex], quantization.offset, inv_scale);
+
+        return packed;
+    }
+
+    Vertex VertexPacker::unpack(const PackedVertex& vertex, const Quantization& quantization) {
+        glm::vec3 position = glm::vec3(
+            std::max(vertex.position[0] / 32767.0f, -1.0f),
+            std::max(vertex.position[1] / 32767.0f, -1.0f),
+            std::max(vertex.position[2] / 32767.0f, -1.0f));
+
+        return Vertex(
+            quantization.offset + quantization.scale * position,
+            VertexPacker::decode_octahedral(vertex.normal),
+            glm::vec2(glm::unpackHalf1x16(vertex.tex_coords[0]), glm::unpackHalf1x16(vertex.tex_coords[1])));
+    }
+
+    void VertexPacker::encode_octahedral(const glm::vec3& normal, int16_t encoded[2]) {
+        float sum = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+        float inv_sum = 1.0f / (sum > k_octahedral_min_sum ? sum : k_octahedral_min_sum);
+        glm::vec3 projected = normal * inv_sum;
+
+        float x = projected.x;
+        float y = projected.y;
+
+        if (projected.z < 0.0f) {
+            x = (1.0f - std::abs(projected.y)) * std::copysign(1.0f, projected.x);
+            y = (1.0f - std::abs(projected.x)) * std::copysign(1.0f, projected.y);
+        }
+
+        encoded[0] = quantize_snorm16(x);
+        encoded[1] = quantize_snorm16(y);
+    }
+
+    glm::vec3 VertexPacker::decode_octahedral(const int16_t encoded[2]) {
+        glm::vec3 normal = glm::vec3(
+            std::max(encoded[0] / 32767.0f, -1.0f),
+            std::max(encoded[1] / 32767.0f, -1.0f),
+            0.0f);
+        normal.z = 1.0f - std::abs(normal.x) - std::abs(normal.y);
+
+        float fold = std::max(-normal.z, 0.0f);
+        normal.x += normal.x >= 0.0f ? -fold : fold;
+        normal.y += normal.y >= 0.0f ? -fold : fold;
+
+        return glm::normalize(normal);
+    }
+
+}
@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <thread>
+
+#include <glm/gtc/packing.hpp>
+
+#include <gfx/vertex_welder.h>
+#include <core/error_handler.h>
+
+namespace bskgl {
+
+    static constexpr uint32_t k_empty = std::numeric_limits<uint32_t>::max();
+
+    // what two vertices are compared by
+    struct WeldContext {
+        const uint8_t* data;
+        const VertexLayout* layout;
+        uint32_t stride;
+        float inv_epsilon;
+    };
+
+    static uint64_t hash_combine(uint64_t hash, uint64_t value) {
+        hash = (hash ^ value) * 0xFF51AFD7ED558CCDull;
+        return hash ^ (hash >> 32);
+    }
+
+    // snaps a float to its grid cell, values that can't be snapped keep their bits
+    static uint64_t snap(float value, float inv_epsilon) {
+        double cell = std::floor(static_cast<double>(value) * inv_epsilon + 0.5);
+
+        if (!std::isfinite(cell) || std::abs(cell) > 4.0e18) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        return static_cast<uint64_t>(static_cast<int64_t>(cell));
+    }
+
+    // value a component is compared by in epsilon mode, only float components are snapped
+    static uint64_t component_key(const uint8_t* data, VertexAttributeType type, float inv_epsilon) {
+        switch (type) {
+            case VertexAttributeType::Float: {
+                float value;
+                std::memcpy(&value, data, sizeof(value));
+                return snap(value, inv_epsilon);
+            }
+            case VertexAttributeType::HalfFloat: {
+                uint16_t half;
+                std::memcpy(&half, data, sizeof(half));
+                return snap(glm::unpackHalf1x16(half), inv_epsilon);
+            }
+            default: {
+                uint32_t bits = 0;
+                std::memcpy(&bits, data, vertex_attribute_type_size(type));
+                return bits;
+            }
+        }
+    }
+
+    static uint64_t hash_vertex(const WeldContext& context, size_t vertex) {
+        const uint8_t* data = context.data + vertex * context.stride;
+        uint64_t hash = 0x9E3779B97F4A7C15ull;
+
+        if (context.inv_epsilon == 0.0f) {
+            size_t offset = 0;
+
+            for (; offset + sizeof(uint64_t) <= context.stride; offset += sizeof(uint64_t)) {
+                uint64_t word;
+                std::memcpy(&word, data + offset, sizeof(word));
+                hash = hash_combine(hash, word);
+            }
+
+            for (; offset < context.stride; offset++)
+                hash = hash_combine(hash, data[offset]);
+
+            return hash;
+        }
+
+        for (const VertexAttribute& attribute : context.layout->attributes()) {
+            uint32_t size = vertex_attribute_type_size(attribute.type);
+
+            for (uint32_t component = 0; component < attribute.components; component++)
+                hash = hash_combine(hash, component_key(data + attribute.offset + component * size, attribute.type, context.inv_epsilon));
+        }
+
+        return hash;
+    }
+
+    static bool equal_vertices(const WeldContext& context, size_t a, size_t b) {
+        const uint8_t* first = context.data + a * context.stride;
+        const uint8_t* second = context.data + b * context.stride;
+
+        if (context.inv_epsilon == 0.0f)
+            return std::memcmp(first, second, context.stride) == 0;
+
+        for (const VertexAttribute& attribute : context.layout->attributes()) {
+            uint32_t size = vertex_attribute_type_size(attribute.type);
+
+            for (uint32_t component = 0; component < attribute.components; component++) {
+                uint32_t offset = attribute.offset + component * size;
+
+                if (component_key(first + offset, attribute.type, context.inv_epsilon) != component_key(second + offset, attribute.type, context.inv_epsilon))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    // runs every task, task 0 on the calling thread
+    static void run_tasks(size_t tasks, const std::function<void(size_t)>& task) {
+        std::vector<std::thread> threads;
+        threads.reserve(tasks > 0 ? tasks - 1 : 0);
+
+        for (size_t index = 1; index < tasks; index++)
+            threads.emplace_back(task, index);
+
+        if (tasks > 0)
+            task(0);
+
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    // keeps the first occurrence of every vertex, in input order
+    static void compact(VertexData& vertices, const std::vector<uint32_t>& remap, size_t unique) {
+        uint32_t stride = vertices.layout().stride();
+        std::vector<uint8_t> bytes(unique * stride);
+        uint32_t written = 0;
+
+        for (size_t vertex = 0; vertex < remap.size(); vertex++) {
+            if (remap[vertex] == written) {
+                std::memcpy(bytes.data() + static_cast<size_t>(written) * stride, vertices.data() + vertex * stride, stride);
+                written++;
+            }
+        }
+
+        vertices = VertexData(vertices.layout(), std::move(bytes));
+    }
+
+    std::vector<uint32_t> VertexWelder::weld(VertexData& vertices, float epsilon) {
+        if (vertices.size() % 3 != 0)
+            BSK_WARNING("Welding triangle soup whose number of vertices isn't a multiple of three.");
+
+        std::vector<uint32_t> remap;
+        size_t unique = VertexWelder::generate_remap(vertices, remap, epsilon);
+
+        if (vertices.data())
+            compact(vertices, remap, unique);
+
+        // the remap of the soup is its index buffer
+        return remap;
+    }
+
+    std::vector<uint32_t> VertexWelder::weld(VertexData& vertices, std::span<const uint32_t> indices, float epsilon) {
+        for (uint32_t index : indices) {
+            if (index >= vertices.size()) {
+                BSK_ERROR("Welding found an index outside of the vertices.");
+                return std::vector<uint32_t>(indices.begin(), indices.end());
+            }
+        }
+
+        std::vector<uint32_t> remap;
+        size_t unique = VertexWelder::generate_remap(vertices, remap, epsilon);
+
+        if (vertices.data())
+            compact(vertices, remap, unique);
+
+        std::vector<uint32_t> result(indices.size());
+        for (size_t index = 0; index < indices.size(); index++)
+            result[index] = remap[indices[index]];
+
+        return result;
+    }
+
+    size_t VertexWelder::generate_remap(const VertexData& vertices, std::vector<uint32_t>& remap, float epsilon) {
+        size_t count = vertices.size();
+        remap.resize(count);
+
+        // released vertices can't be compared, every vertex stays unique
+        if (!vertices.data()) {
+            if (count != 0)
+                BSK_ERROR("Released vertex data can't be welded.");
+
+            for (size_t vertex = 0; vertex < count; vertex++)
+                remap[vertex] = static_cast<uint32_t>(vertex);
+
+            return count;
+        }
+
+        WeldContext context = { vertices.data(), &vertices.layout(), vertices.layout().stride(), epsilon > 0.0f ? 1.0f / epsilon : 0.0f };
+
+        size_t tasks = count >= parallel_threshold ? std::max<size_t>(std::thread::hardware_concurrency(), 1) : 1;
+
+        // hash in chunks
+        std::vector<uint64_t> hashes(count);
+        size_t chunk = (count + tasks - 1) / tasks;
+
+        run_tasks(tasks, [&](size_t task) {
+            size_t end = std::min(count, (task + 1) * chunk);
+
+            for (size_t vertex = task * chunk; vertex < end; vertex++)
+                hashes[vertex] = hash_vertex(context, vertex);
+        });
+
+        // partition by the high bits of the hash, equal vertices always land in the same partition
+        std::vector<uint32_t> offsets(tasks + 1, 0);
+        std::vector<uint32_t> order(count);
+
+        for (size_t vertex = 0; vertex < count; vertex++)
+            offsets[(hashes[vertex] >> 40) % tasks + 1]++;
+
+        for (size_t task = 0; task < tasks; task++)
+            offsets[task + 1] += offsets[task];
+
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+
+        for (size_t vertex = 0; vertex < count; vertex++)
+            order[fill[(hashes[vertex] >> 40) % tasks]++] = static_cast<uint32_t>(vertex);
+
+        // every partition finds the first occurrence of its vertices with its own open addressing table
+        std::vector<uint32_t> first(count);
+
+        run_tasks(tasks, [&](size_t task) {
+            size_t begin = offsets[task];
+            size_t end = offsets[task + 1];
+
+            size_t capacity = std::bit_ceil(std::max<size_t>((end - begin) * 2, 16));
+            std::vector<uint32_t> table(capacity, k_empty);
+
+            for (size_t position = begin; position < end; position++) {
+                uint32_t vertex = order[position];
+
+                for (size_t slot = hashes[vertex] & (capacity - 1);; slot = (slot + 1) & (capacity - 1)) {
+                    uint32_t existing = table[slot];
+
+                    if (existing == k_empty) {
+                        table[slot] = vertex;
+                        first[vertex] = vertex;
+                        break;
+                    }
+
+                    if (hashes[existing] == hashes[vertex] && equal_vertices(context, existing, vertex)) {
+                        first[vertex] = existing;
+                        break;
+                    }
+                }
+            }
+        });
+
+        // number the unique vertices in input order, a first occurrence always comes before its duplicates
+        size_t unique = 0;
+
+        for (size_t vertex = 0; vertex < count; vertex++)
+            remap[vertex] = first[vertex] == vertex ? static_cast<uint32_t>(unique++) : remap[first[vertex]];
+
+        return unique;
+    }
+
+}
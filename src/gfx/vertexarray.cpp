@@ -3,15 +3,21 @@
 
 #include <gfx/vertexarray.h>
 #include <context/asset_manager.h>
+#include <context/gl_state_cache.h>
+#include <core/error_handler.h>
 
 namespace bskgl {
 
+    // buffer binding points of the vertex array
+    static constexpr uint32_t vertex_binding = 0;
+    static constexpr uint32_t instance_binding = 1;
+
     VertexArray::VertexArray(UUID uuid, std::shared_ptr<VertexBuffer> vbuffer, std::shared_ptr<IndexBuffer> ibuffer)
         :
         m_uuid(uuid),
         m_vbuffer(std::move(vbuffer)),
         m_ibuffer(std::move(ibuffer)) {
-        glGenVertexArrays(1, &m_glid);
+        glCreateVertexArrays(1, &m_glid);
         this->sync();
     }
 
@@ -20,7 +26,11 @@ namespace bskgl {
         m_uuid(other.m_uuid),
         m_glid(other.m_glid),
         m_vbuffer(std::move(other.m_vbuffer)),
-        m_ibuffer(std::move(other.m_ibuffer)) {
+        m_ibuffer(std::move(other.m_ibuffer)),
+        m_instance_buffer(std::move(other.m_instance_buffer)),
+        m_vertex_stream(std::move(other.m_vertex_stream)),
+        m_layout(std::move(other.m_layout)),
+        m_lods(std::move(other.m_lods)) {
         other.m_glid = 0;
     }
 
@@ -32,6 +42,10 @@ namespace bskgl {
         m_glid = other.m_glid;
         m_vbuffer = std::move(other.m_vbuffer);
         m_ibuffer = std::move(other.m_ibuffer);
+        m_instance_buffer = std::move(other.m_instance_buffer);
+        m_vertex_stream = std::move(other.m_vertex_stream);
+        m_layout = std::move(other.m_layout);
+        m_lods = std::move(other.m_lods);
         other.m_glid = 0;
     
         return *this;
@@ -39,6 +53,7 @@ namespace bskgl {
 
     VertexArray::~VertexArray() {
         glDeleteVertexArrays(1, &m_glid);
+        GLStateCache::active().on_vertex_array_deleted(m_glid);
     }
 
     UUID VertexArray::uuid() const {
@@ -49,8 +64,12 @@ namespace bskgl {
         return m_glid;
     }
 
-    const std::vector<Vertex>& VertexArray::vertices() const {
-        return m_vbuffer->vertices();
+    const VertexData& VertexArray::vertex_data() const {
+        return m_vbuffer->vertex_data();
+    }
+
+    const VertexLayout& VertexArray::layout() const {
+        return m_vbuffer->layout();
     }
 
     const std::vector<uint32_t>& VertexArray::indices() const {
@@ -65,6 +84,14 @@ namespace bskgl {
         return m_ibuffer? m_ibuffer->num_indices() : 0;
     }
 
+    IndexType VertexArray::index_type() const {
+        return m_ibuffer? m_ibuffer->index_type() : IndexType::UnsignedInt;
+    }
+
+    const Bounds& VertexArray::bounds() const {
+        return m_vbuffer->bounds();
+    }
+
     UUID VertexArray::vbuffer() const {
         return m_vbuffer->uuid();
     }
@@ -75,8 +102,8 @@ namespace bskgl {
         return BSK_INVALID_UUID;
     }
 
-    VertexArray& VertexArray::set_vertices(const std::vector<Vertex>& vertices) {
-        m_vbuffer->set_vertices(vertices);
+    VertexArray& VertexArray::set_vertices(VertexData vertices) {
+        m_vbuffer->set_vertices(std::move(vertices));
         return *this;
     }
 
@@ -84,58 +111,177 @@ namespace bskgl {
         if (m_ibuffer)
             m_ibuffer->set_indices(indices);
 
+        m_lods.clear();
+
         return *this;
     }
 
-    void VertexArray::bind() const {
-        glBindVertexArray(m_glid);
-        m_vbuffer->bind();
+    VertexArray& VertexArray::set_indices(std::vector<uint32_t>&& indices) {
+        if (m_ibuffer)
+            m_ibuffer->set_indices(std::move(indices));
+
+        m_lods.clear();
+
+        return *this;
+    }
+
+    VertexArray& VertexArray::set_lods(const std::vector<std::vector<uint32_t>>& levels, const std::vector<float>& errors) {
+        if (!m_ibuffer || levels.size() != errors.size()) {
+            BSK_ERROR("Levels of detail need an index buffer and an error per level.");
+            return *this;
+        }
+
+        std::vector<uint32_t> indices;
+        std::vector<LodLevel> lods;
+        lods.reserve(levels.size());
+
+        for (size_t level = 0; level < levels.size(); level++) {
+            lods.push_back({ static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(levels[level].size()), errors[level] });
+            indices.insert(indices.end(), levels[level].begin(), levels[level].end());
+        }
 
+        this->set_indices(std::move(indices));
+
+        return this->set_lods(std::move(lods));
+    }
+
+    VertexArray& VertexArray::set_lods(std::vector<LodLevel> lods) {
+        size_t num_indices = this->num_indices();
+
+        for (size_t level = 0; level < lods.size(); level++) {
+            const LodLevel& lod = lods[level];
+
+            if (static_cast<size_t>(lod.first_index) + lod.num_indices > num_indices || lod.num_indices == 0) {
+                BSK_ERROR("Level of detail is outside of the indices.");
+                return *this;
+            }
+
+            // selection walks the levels from the coarsest one and stops at the first acceptable one
+            if (level > 0 && lod.error < lods[level - 1].error) {
+                BSK_ERROR("Errors of the levels of detail have to be non decreasing.");
+                return *this;
+            }
+        }
+
+        m_lods = std::move(lods);
+
+        return *this;
+    }
+
+    const std::vector<LodLevel>& VertexArray::lods() const {
+        return m_lods;
+    }
+
+    VertexArray& VertexArray::update_indices(size_t offset, std::span<const uint32_t> indices) {
         if (m_ibuffer)
-            m_ibuffer->bind();
+            m_ibuffer->update_indices(offset, indices);
+
+        return *this;
     }
 
-    VertexArray& VertexArray::sync() {
-        // bind this vertex array
-        this->bind();
+    VertexArray& VertexArray::set_residency(Residency residency) {
+        m_vbuffer->set_residency(residency);
+
+        if (m_ibuffer)
+            m_ibuffer->set_residency(residency);
 
+        return *this;
+    }
+
+    VertexArray& VertexArray::attach_instance_buffer(std::shared_ptr<InstanceBuffer> ibuffer) {
+        m_instance_buffer = std::move(ibuffer);
+
+        if (!m_instance_buffer)
+            return *this;
+
+        // the instance buffer has its own binding point, advancing once per instance
+        glVertexArrayVertexBuffer(m_glid, instance_binding, m_instance_buffer->gl_id(), 0, static_cast<GLsizei>(m_instance_buffer->stride()));
+        glVertexArrayBindingDivisor(m_glid, instance_binding, 1);
+
+        // set per-instance attributes, a mat4 takes up four consecutive locations
+        uint32_t location = m_instance_buffer->first_location();
+        uint32_t offset = 0;
+
+        for (InstanceAttribute attribute : m_instance_buffer->layout()) {
+            for (uint32_t column = 0; column < static_cast<uint32_t>(attribute); column++) {
+                glEnableVertexArrayAttrib(m_glid, location);
+                glVertexArrayAttribFormat(m_glid, location, 4, GL_FLOAT, GL_FALSE, offset);
+                glVertexArrayAttribBinding(m_glid, location, instance_binding);
+
+                location++;
+                offset += 4 * sizeof(float);
+            }
+        }
+
+        return *this;
+    }
+
+    UUID VertexArray::instance_buffer() const {
+        if (m_instance_buffer)
+            return m_instance_buffer->uuid();
+        return BSK_INVALID_UUID;
+    }
+
+    VertexArray& VertexArray::attach_vertex_stream(std::shared_ptr<StreamBuffer> stream) {
+        m_vertex_stream = std::move(stream);
+
+        if (!m_vertex_stream)
+            return this->sync();
+
+        // source the vertex attributes from the stream buffer
+        glVertexArrayVertexBuffer(m_glid, vertex_binding, m_vertex_stream->gl_id(), 0, m_vbuffer->layout().stride());
+
+        // set vertex attributes
+        this->m_set_vertex_attributes();
+
+        return *this;
+    }
+
+    void VertexArray::bind() const {
+        // the buffers are attached to the vertex array, binding it is enough
+        GLStateCache::active().bind_vertex_array(m_glid);
+    }
+
+    VertexArray& VertexArray::sync() {
         // sync the vertex buffer
         m_vbuffer->sync();
 
         // sync the index buffer
         if (m_ibuffer)
             m_ibuffer->sync();
-        
-        // reattach the buffers to this vertex array (rebind them)
-        m_vbuffer->bind();
 
-        if (m_ibuffer)
-            m_ibuffer->bind();
+        // reattach the buffers to this vertex array, a reallocated buffer may have a new ID
+        glVertexArrayVertexBuffer(m_glid, vertex_binding, m_vbuffer->gl_id(), 0, m_vbuffer->layout().stride());
+        glVertexArrayElementBuffer(m_glid, m_ibuffer ? m_ibuffer->gl_id() : 0);
+        GLStateCache::active().on_vertex_array_modified(m_glid);
 
         // set vertex attributes
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*) offsetof(Vertex, position));
-
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*) offsetof(Vertex, normal));
-
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*) offsetof(Vertex, tex_coords));
+        this->m_set_vertex_attributes();
 
-        // unbind this vertex array
-        VertexArray::unbind();
+        m_vertex_stream = nullptr;
 
         return *this;
     }
 
     bool VertexArray::does_ibuffer_exist() const {
-        return m_ibuffer->num_indices() > 0;
+        return m_ibuffer && m_ibuffer->num_indices() > 0;
+    }
+
+    void VertexArray::m_set_vertex_attributes() {
+        const VertexLayout& layout = m_vbuffer->layout();
+
+        // attributes the new layout doesn't have would keep reading the old buffer
+        for (const VertexAttribute& attribute : m_layout.attributes()) {
+            if (!layout.find(attribute.location))
+                glDisableVertexArrayAttrib(m_glid, attribute.location);
+        }
+
+        layout.apply(m_glid, vertex_binding);
+        m_layout = layout;
     }
 
     void VertexArray::unbind() {
-        glBindVertexArray(0);
-        VertexBuffer::unbind();
-        IndexBuffer::unbind();
+        GLStateCache::active().bind_vertex_array(0);
     }
 
 }
\ No newline at end of file
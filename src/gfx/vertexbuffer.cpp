@@ -1,29 +1,32 @@
 #include <glad/glad.h>
 
+#include <cstring>
+
 #include <gfx/vertexbuffer.h>
+#include <context/gl_state_cache.h>
+#include <core/error_handler.h>
 
 namespace bskgl {
 
-    VertexBuffer::VertexBuffer(UUID uuid, size_t num_vertices)
+    VertexBuffer::VertexBuffer(UUID uuid, size_t num_vertices, BufferUsage usage)
         :
-        m_uuid(uuid),
-        m_vertices(num_vertices, bskgl::Vertex()) {
-        glGenBuffers(1, &m_glid);
-    }
+        VertexBuffer(uuid, VertexData(std::vector<Vertex>(num_vertices, bskgl::Vertex())), usage) { }
 
-    VertexBuffer::VertexBuffer(UUID uuid, const std::vector<Vertex>& vertices)
+    VertexBuffer::VertexBuffer(UUID uuid, VertexData vertices, BufferUsage usage)
         :
         m_uuid(uuid),
-        m_vertices(vertices) {
-        glGenBuffers(1, &m_glid);
-    }
+        m_storage(usage),
+        m_vertices(std::move(vertices)) { }
 
     VertexBuffer::VertexBuffer(VertexBuffer&& other) noexcept 
         :
         m_uuid(other.m_uuid),
-        m_glid(other.m_glid),
-        m_vertices(std::move(other.m_vertices)) {
-        other.m_glid = 0;
+        m_storage(std::move(other.m_storage)),
+        m_vertices(std::move(other.m_vertices)),
+        m_bounds(other.m_bounds),
+        m_dirty(std::move(other.m_dirty)),
+        m_residency(other.m_residency),
+        m_released(std::move(other.m_released)) {
     }
 
     VertexBuffer& VertexBuffer::operator=(VertexBuffer&& other) noexcept {
@@ -31,28 +34,51 @@ namespace bskgl {
             return *this;
 
         m_uuid = other.m_uuid;
-        m_glid = other.m_glid;
+        m_storage = std::move(other.m_storage);
         m_vertices = std::move(other.m_vertices);
-
-        other.m_glid = 0;
+        m_bounds = other.m_bounds;
+        m_dirty = std::move(other.m_dirty);
+        m_residency = other.m_residency;
+        m_released = std::move(other.m_released);
 
         return *this;
     }
 
-    VertexBuffer::~VertexBuffer() {
-        if (m_glid != 0)
-            glDeleteBuffers(1, &m_glid);
-    }
+    VertexBuffer::~VertexBuffer() = default;
 
     UUID VertexBuffer::uuid() const {
         return m_uuid;
     }
 
     uint32_t VertexBuffer::gl_id() const {
-        return m_glid;
+        return m_storage.gl_id();
+    }
+
+    BufferUsage VertexBuffer::usage() const {
+        return m_storage.usage();
+    }
+
+    Residency VertexBuffer::residency() const {
+        return m_residency;
     }
 
-    const std::vector<Vertex>& VertexBuffer::vertices() const {
+    VertexBuffer& VertexBuffer::set_residency(Residency residency) {
+        m_residency = residency;
+
+        if (m_residency == Residency::Shadowed)
+            m_restore();
+        else if (m_dirty.empty())
+            m_release();
+
+        return *this;
+    }
+
+    const VertexLayout& VertexBuffer::layout() const {
+        return m_vertices.layout();
+    }
+
+    const VertexData& VertexBuffer::vertex_data() const {
+        m_restore();
         return m_vertices;
     }
 
@@ -60,31 +86,80 @@ namespace bskgl {
         return m_vertices.size();
     }
 
-    VertexBuffer& VertexBuffer::set_vertices(const std::vector<Vertex>& vertices) {
-        m_vertices = vertices;
+    const Bounds& VertexBuffer::bounds() const {
+        return m_bounds;
+    }
+
+    VertexBuffer& VertexBuffer::set_vertices(VertexData vertices) {
+        // the released copy is replaced, there's nothing to read back
+        m_released.discard();
+
+        m_vertices = std::move(vertices);
+        m_dirty.mark_all();
 
         return *this;
     }
 
     void VertexBuffer::bind() const {
-        glBindBuffer(GL_ARRAY_BUFFER, m_glid);
+        GLStateCache::active().bind_buffer(GL_ARRAY_BUFFER, m_storage.gl_id());
     }
 
     VertexBuffer& VertexBuffer::sync() {
-        // bind the buffer
-        this->bind();
+        // a released copy hasn't been modified since it was uploaded
+        if (m_released.released())
+            return *this;
+
+        // upload the modified vertices, the bounds are exact again once the whole buffer is uploaded
+        if (m_storage.upload(m_vertices.data(), m_vertices.size_bytes(), m_dirty, m_vertices.layout().stride()))
+            m_bounds = Bounds::from_vertices(m_vertices);
 
-        // update the buffer
-        glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(Vertex), m_vertices.data(), GL_DYNAMIC_DRAW);
+        m_dirty.clear();
 
-        // unbind the buffer
-        VertexBuffer::unbind();
+        if (m_residency == Residency::GPUOnly)
+            m_release();
 
         return *this;
     }
 
     void VertexBuffer::unbind() {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        GLStateCache::active().bind_buffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    VertexBuffer& VertexBuffer::m_update(size_t offset, const uint8_t* data, size_t count) {
+        m_restore();
+
+        if (offset > m_vertices.size() || count > m_vertices.size() - offset) {
+            BSK_ERROR("Vertex update is out of the buffer range.");
+            return *this;
+        }
+
+        const VertexLayout& layout = m_vertices.layout();
+        std::memcpy(m_vertices.data() + offset * layout.stride(), data, count * layout.stride());
+        m_dirty.mark(offset, offset + count);
+
+        // the old positions may still be the extremes, so the bounds can only grow until the next full upload
+        for (size_t vertex = 0; vertex < count; vertex++)
+            m_bounds.expand(layout.position(data + vertex * layout.stride()));
+
+        return *this;
+    }
+
+    void VertexBuffer::m_release() {
+        if (m_released.released() || m_vertices.size() == 0)
+            return;
+
+        m_released.release(m_vertices.size_bytes());
+        m_vertices.release();
+    }
+
+    void VertexBuffer::m_restore() const {
+        if (!m_released.can_read_back("Released vertices"))
+            return;
+
+        m_vertices.reallocate();
+        m_storage.read(m_vertices.data());
+
+        m_released.restored();
     }
 
 }
\ No newline at end of file
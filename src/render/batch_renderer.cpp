@@ -0,0 +1,187 @@
+#include <glad/glad.h>
+#include <cstring>
+
+#include <render/batch_renderer.h>
+#include <context/render_context.h>
+#include <gfx/vertexarray.h>
+#include <gfx/streambuffer.h>
+#include <gfx/shader.h>
+#include <gfx/texture/texture2d.h>
+#include <core/error_handler.h>
+#include <core/convert_values.h>
+
+namespace bskgl {
+
+    BatchRenderer::BatchRenderer(RenderContext& parent_context, size_t max_quads)
+        :
+        m_parent_ctx(parent_context),
+        m_max_quads(max_quads),
+        m_staging() {
+        BSK_VERIFY(max_quads != 0, "Batch renderer needs to hold atleast one quad.");
+        m_staging.reserve(m_max_quads * 4);
+    }
+
+    BatchRenderer::BatchRenderer(BatchRenderer&& other) noexcept
+        :
+        m_parent_ctx(other.m_parent_ctx),
+        m_max_quads(other.m_max_quads),
+        m_va(other.m_va),
+        m_stream(other.m_stream),
+        m_shader(other.m_shader),
+        m_texture(other.m_texture),
+        m_staging(std::move(other.m_staging)),
+        m_stats(other.m_stats) {
+        other.m_va = BSK_INVALID_UUID;
+        other.m_stream = BSK_INVALID_UUID;
+    }
+
+    BatchRenderer::~BatchRenderer() {
+
+    }
+
+    void BatchRenderer::begin(UUID shader) {
+        if (m_va == static_cast<UUID>(BSK_INVALID_UUID))
+            m_create_buffers();
+
+        // start writing the next region, the previous batch's region is fenced
+        auto stream = m_parent_ctx.asset_manager.get_asset<StreamBuffer>(m_stream);
+        m_parent_ctx.execute([stream]() { stream->next_region(); });
+
+        m_staging.clear();
+        m_shader = shader;
+        m_texture = BSK_INVALID_UUID;
+        m_stats = Statistics();
+    }
+
+    void BatchRenderer::set_shader(UUID shader) {
+        if (shader == m_shader)
+            return;
+
+        this->flush();
+        m_shader = shader;
+    }
+
+    void BatchRenderer::submit_quad(const glm::vec3& position, const glm::vec2& size, UUID texture, const glm::vec4& tex_rect) {
+        const glm::vec3 corners[4] = {
+            position,
+            position + glm::vec3(size.x, 0.0f, 0.0f),
+            position + glm::vec3(size.x, size.y, 0.0f),
+            position + glm::vec3(0.0f, size.y, 0.0f)
+        };
+
+        m_push_quad(corners, texture, tex_rect);
+    }
+
+    void BatchRenderer::submit_quad(const glm::mat4& transform, UUID texture, const glm::vec4& tex_rect) {
+        const glm::vec3 corners[4] = {
+            glm::vec3(transform * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)),
+            glm::vec3(transform * glm::vec4(1.0f, 0.0f, 0.0f, 1.0f)),
+            glm::vec3(transform * glm::vec4(1.0f, 1.0f, 0.0f, 1.0f)),
+            glm::vec3(transform * glm::vec4(0.0f, 1.0f, 0.0f, 1.0f))
+        };
+
+        m_push_quad(corners, texture, tex_rect);
+    }
+
+    void BatchRenderer::flush() {
+        if (m_staging.empty())
+            return;
+
+        auto va = m_parent_ctx.asset_manager.get_asset<VertexArray>(m_va);
+        auto stream = m_parent_ctx.asset_manager.get_asset<StreamBuffer>(m_stream);
+        auto shader = m_parent_ctx.asset_manager.get_asset<Shader>(m_shader);
+        auto texture = m_parent_ctx.asset_manager.get_asset<Texture2D>(m_texture);
+
+        if (!shader) {
+            BSK_ERROR("Invalid asset UUID given.")
+            m_staging.clear();
+            return;
+        }
+
+        auto draw = [va, stream, shader, texture](const std::vector<Vertex>& vertices, const Shader::Uniforms& uniforms) {
+            // programs still compiling drop the quads
+            if (!shader->bind(uniforms))
+                return;
+
+            // write the pending quads straight into mapped memory, the index buffer is static
+            StreamBuffer::Allocation allocation = stream->allocate(vertices.size() * sizeof(Vertex), sizeof(Vertex));
+            if (!allocation.data)
+                return;
+
+            std::memcpy(allocation.data, vertices.data(), vertices.size() * sizeof(Vertex));
+
+            if (texture)
+                texture->bind();
+            va->bind();
+
+            glDrawElementsBaseVertex(GL_TRIANGLES, (vertices.size() / 4) * 6, opengl::convert(va->index_type()), nullptr, allocation.offset / sizeof(Vertex));
+        };
+
+        if (m_parent_ctx.render_thread()) {
+            // the render thread writes a copy, in order with the draws recorded before
+            m_parent_ctx.execute([draw, vertices = m_staging, uniforms = shader->uniforms()]() { draw(vertices, uniforms); });
+        } else {
+            m_parent_ctx.bind();
+            draw(m_staging, shader->uniforms());
+        }
+
+        m_stats.draw_calls++;
+        m_staging.clear();
+    }
+
+    void BatchRenderer::end() {
+        this->flush();
+    }
+
+    size_t BatchRenderer::max_quads() const {
+        return m_max_quads;
+    }
+
+    const BatchRenderer::Statistics& BatchRenderer::statistics() const {
+        return m_stats;
+    }
+
+    void BatchRenderer::m_create_buffers() {
+        // every quad is made of two triangles sharing the diagonal
+        std::vector<uint32_t> indices(m_max_quads * 6);
+        for (uint32_t quad = 0; quad < m_max_quads; quad++) {
+            uint32_t first_vertex = quad * 4;
+            uint32_t* index = &indices[quad * 6];
+
+            index[0] = first_vertex + 0;
+            index[1] = first_vertex + 1;
+            index[2] = first_vertex + 2;
+            index[3] = first_vertex + 2;
+            index[4] = first_vertex + 3;
+            index[5] = first_vertex + 0;
+        }
+
+        // vertices are streamed, the vertex buffer stays empty
+        m_va = m_parent_ctx.asset_manager.create_asset<VertexArray>(std::vector<Vertex>(), indices, BufferUsage::Static);
+        m_stream = m_parent_ctx.asset_manager.create_asset<StreamBuffer>(m_max_quads * 4 * sizeof(Vertex));
+
+        auto va = m_parent_ctx.asset_manager.get_asset<VertexArray>(m_va);
+        auto stream = m_parent_ctx.asset_manager.get_asset<StreamBuffer>(m_stream);
+        m_parent_ctx.execute_sync([va, stream]() { va->attach_vertex_stream(stream); });
+    }
+
+    void BatchRenderer::m_push_quad(const glm::vec3 (&corners)[4], UUID texture, const glm::vec4& tex_rect) {
+        if (texture != m_texture) {
+            this->flush();
+            m_texture = texture;
+        }
+        else if (m_staging.size() + 4 > m_max_quads * 4) {
+            this->flush();
+        }
+
+        static constexpr glm::vec3 normal = glm::vec3(0.0f, 0.0f, 1.0f);
+
+        m_staging.emplace_back(corners[0], normal, glm::vec2(tex_rect.x, tex_rect.y));
+        m_staging.emplace_back(corners[1], normal, glm::vec2(tex_rect.z, tex_rect.y));
+        m_staging.emplace_back(corners[2], normal, glm::vec2(tex_rect.z, tex_rect.w));
+        m_staging.emplace_back(corners[3], normal, glm::vec2(tex_rect.x, tex_rect.w));
+
+        m_stats.quads++;
+    }
+
+}
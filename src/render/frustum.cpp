@@ -0,0 +1,108 @@
+#include <cmath>
+
+#include <render/frustum.h>
+#include <camera/perspective_camera.h>
+#include <camera/player_camera.h>
+
+namespace bskgl {
+
+    void Frustum::Spheres::push_back(const glm::vec3& center, float r) {
+        x.push_back(center.x);
+        y.push_back(center.y);
+        z.push_back(center.z);
+        radius.push_back(r);
+    }
+
+    void Frustum::Spheres::clear() {
+        x.clear();
+        y.clear();
+        z.clear();
+        radius.clear();
+    }
+
+    size_t Frustum::Spheres::size() const {
+        return radius.size();
+    }
+
+    Frustum::Frustum() {
+        // every point is at a distance of one in front of every plane
+        m_planes.fill(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    }
+
+    Frustum::Frustum(const glm::mat4& view_projection) {
+        // rows of the matrix, glm is column major
+        glm::vec4 rows[4];
+        for (int32_t i = 0; i < 4; i++)
+            rows[i] = glm::vec4(view_projection[0][i], view_projection[1][i], view_projection[2][i], view_projection[3][i]);
+
+        // clip space is -w <= x, y, z <= w
+        m_planes = {
+            rows[3] + rows[0],
+            rows[3] - rows[0],
+            rows[3] + rows[1],
+            rows[3] - rows[1],
+            rows[3] + rows[2],
+            rows[3] - rows[2]
+        };
+
+        for (glm::vec4& plane : m_planes) {
+            float length = glm::length(glm::vec3(plane));
+            if (length > 0.0f)
+                plane = plane / length;
+        }
+    }
+
+    Frustum::Frustum(const PerspectiveCamera& camera)
+        :
+        Frustum(camera.view_projection_matrix()) { }
+
+    Frustum::Frustum(const PlayerCamera& camera)
+        :
+        Frustum(camera.view_projection_matrix()) { }
+
+    const std::array<glm::vec4, 6>& Frustum::planes() const {
+        return m_planes;
+    }
+
+    bool Frustum::intersects(const Bounds& bounds) const {
+        for (const glm::vec4& plane : m_planes) {
+            // corner of the box farthest along the plane normal
+            glm::vec3 corner(
+                plane.x >= 0.0f? bounds.max.x : bounds.min.x,
+                plane.y >= 0.0f? bounds.max.y : bounds.min.y,
+                plane.z >= 0.0f? bounds.max.z : bounds.min.z
+            );
+
+            if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+                return false;
+        }
+
+        return true;
+    }
+
+    size_t Frustum::cull(const Spheres& spheres, std::vector<uint8_t>& visible) const {
+        const size_t count = spheres.size();
+        visible.assign(count, 1);
+
+        const float* xs = spheres.x.data();
+        const float* ys = spheres.y.data();
+        const float* zs = spheres.z.data();
+        const float* rs = spheres.radius.data();
+        uint8_t* out = visible.data();
+
+        // one plane per pass, the inner loop is branchless so the compiler can vectorize it
+        for (const glm::vec4& plane : m_planes) {
+            const float px = plane.x, py = plane.y, pz = plane.z, pw = plane.w;
+
+            for (size_t i = 0; i < count; i++)
+                out[i] &= static_cast<uint8_t>(px * xs[i] + py * ys[i] + pz * zs[i] + pw >= -rs[i]);
+        }
+
+        size_t num_visible = 0;
+        for (size_t i = 0; i < count; i++)
+            num_visible += out[i];
+
+        return num_visible;
+    }
+
+}
@@ -0,0 +1,66 @@
+#include <cmath>
+
+#include <render/lod_selector.h>
+#include <camera/camera.h>
+
+namespace bskgl {
+
+    LodSelector::LodSelector()
+        :
+        m_eye(0.0f),
+        m_pixels_per_unit(0.0f),
+        m_perspective(false),
+        m_threshold(default_threshold),
+        m_hysteresis(default_hysteresis) { }
+
+    LodSelector::LodSelector(const CameraBase& camera, float viewport_height, float threshold, float hysteresis)
+        :
+        m_eye(camera.position()),
+        m_pixels_per_unit(0.0f),
+        m_perspective(false),
+        m_threshold(threshold),
+        m_hysteresis(hysteresis) {
+        glm::mat4 projection = camera.projection_matrix();
+
+        // the projection scales y to clip space, half the viewport spans one clip space unit
+        m_pixels_per_unit = std::abs(projection[1][1]) * viewport_height * 0.5f;
+
+        // a perspective projection moves the distance into w
+        m_perspective = projection[3][3] == 0.0f;
+    }
+
+    float LodSelector::projected_error(float error, const glm::vec3& center, float radius) const {
+        if (!m_perspective)
+            return error * m_pixels_per_unit;
+
+        float distance = glm::length(center - m_eye) - radius;
+        if (distance <= 0.0f)
+            return INFINITY;
+
+        return error * m_pixels_per_unit / distance;
+    }
+
+    size_t LodSelector::select(std::span<const LodLevel> levels, const glm::vec3& center, float radius, float scale, size_t previous) const {
+        if (levels.empty() || m_pixels_per_unit == 0.0f)
+            return 0;
+
+        // errors are non decreasing, so the projection of the error unit is shared by every level
+        float pixels = this->projected_error(scale, center, radius);
+
+        for (size_t level = levels.size() - 1; level > 0; level--) {
+            // coarser than before has to be well below the threshold, the previous level is kept until it's well above
+            float threshold = m_threshold;
+
+            if (previous != none && level > previous)
+                threshold *= 1.0f - m_hysteresis;
+            else if (level == previous)
+                threshold *= 1.0f + m_hysteresis;
+
+            if (levels[level].error * pixels <= threshold)
+                return level;
+        }
+
+        return 0;
+    }
+
+}
@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <array>
+
+#include <render/render_queue.h>
+
+namespace bskgl {
+
+    void RenderQueue::submit(UUID vertexarray, UUID shader, UUID texture, float depth, uint32_t lod) {
+        uint64_t quantized_depth = static_cast<uint64_t>(std::clamp(depth, 0.0f, 1.0f) * 65535.0f);
+
+        uint64_t key =
+            (m_compact_id(m_shader_ids, shader) << 48) |
+            (m_compact_id(m_texture_ids, texture) << 32) |
+            (m_compact_id(m_va_ids, vertexarray) << 16) |
+            quantized_depth;
+
+        m_commands.push_back({ key, vertexarray, shader, texture, lod });
+    }
+
+    const std::vector<RenderQueue::Command>& RenderQueue::sort() {
+        m_scratch.resize(m_commands.size());
+
+        // least significant digit radix sort, one byte per pass
+        for (uint32_t shift = 0; shift < 64; shift += 8) {
+            std::array<size_t, 257> offsets = {};
+
+            for (const Command& command : m_commands)
+                offsets[((command.key >> shift) & 0xFF) + 1]++;
+
+            // skip passes where every key has the same digit
+            if (std::find(offsets.begin(), offsets.end(), m_commands.size()) != offsets.end())
+                continue;
+
+            for (size_t i = 1; i < offsets.size(); i++)
+                offsets[i] += offsets[i - 1];
+
+            for (const Command& command : m_commands)
+                m_scratch[offsets[(command.key >> shift) & 0xFF]++] = command;
+
+            m_commands.swap(m_scratch);
+        }
+
+        return m_commands;
+    }
+
+    void RenderQueue::retain(const std::vector<uint8_t>& keep) {
+        size_t kept = 0;
+
+        for (size_t i = 0; i < m_commands.size(); i++) {
+            if (i >= keep.size() || keep[i])
+                m_commands[kept++] = m_commands[i];
+        }
+
+        m_commands.resize(kept);
+    }
+
+    void RenderQueue::clear() {
+        m_commands.clear();
+
+        // no key refers to the ids anymore, assets still in use get new ones on their next submit
+        for (auto* ids : { &m_shader_ids, &m_texture_ids, &m_va_ids }) {
+            if (ids->size() >= s_overflow_id)
+                ids->clear();
+        }
+    }
+
+    size_t RenderQueue::size() const {
+        return m_commands.size();
+    }
+
+    bool RenderQueue::empty() const {
+        return m_commands.empty();
+    }
+
+    uint64_t RenderQueue::m_compact_id(std::unordered_map<UUID, uint16_t>& ids, UUID uuid) {
+        auto it = ids.find(uuid);
+        if (it != ids.end())
+            return it->second;
+
+        // out of ids until the next clear, wrapping would give two assets the same id
+        if (ids.size() >= s_overflow_id)
+            return s_overflow_id;
+
+        return ids.emplace(uuid, static_cast<uint16_t>(ids.size())).first->second;
+    }
+
+}
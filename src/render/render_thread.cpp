@@ -0,0 +1,136 @@
+#include <algorithm>
+
+#include <render/render_thread.h>
+#include <context/render_context.h>
+
+namespace bskgl {
+
+    RenderThread::RenderThread(RenderContext& parent_context, uint32_t frames_in_flight)
+        :
+        m_parent_ctx(parent_context),
+        m_lists(std::max(frames_in_flight, 2u)),
+        m_recording(0),
+        m_task(nullptr),
+        m_busy(false),
+        m_stop(false) {
+        for (size_t i = 1; i < m_lists.size(); i++)
+            m_free.push_back(i);
+    }
+
+    RenderThread::~RenderThread() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+
+        m_render_cv.notify_one();
+
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    void RenderThread::record(RenderCommand&& command) {
+        m_lists[m_recording].push_back(std::move(command));
+    }
+
+    void RenderThread::submit_frame() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_submitted.push_back(m_recording);
+        m_render_cv.notify_one();
+
+        // wait for a list the render thread is done with
+        m_app_cv.wait(lock, [this]() { return !m_free.empty(); });
+
+        m_recording = m_free.front();
+        m_free.pop_front();
+    }
+
+    void RenderThread::run_and_wait(const std::function<void()>& task) {
+        if (this->is_render_thread()) {
+            task();
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_task = &task;
+        m_render_cv.notify_one();
+
+        m_app_cv.wait(lock, [this]() { return m_task == nullptr; });
+    }
+
+    void RenderThread::wait_idle() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_app_cv.wait(lock, [this]() { return m_submitted.empty() && !m_busy; });
+    }
+
+    bool RenderThread::is_render_thread() const {
+        return std::this_thread::get_id() == m_thread.get_id();
+    }
+
+    uint32_t RenderThread::frames_in_flight() const {
+        return static_cast<uint32_t>(m_lists.size());
+    }
+
+    void RenderThread::m_start() {
+        // the thread waits on the mutex until m_thread is assigned
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_thread = std::thread(&RenderThread::m_run, this);
+    }
+
+    void RenderThread::m_run() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_parent_ctx.bind();
+
+        while (true) {
+            m_render_cv.wait(lock, [this]() { return m_task || !m_submitted.empty() || m_stop; });
+
+            // tasks run before pending frames, they usually create assets those frames use
+            if (m_task) {
+                const std::function<void()>* task = m_task;
+
+                lock.unlock();
+                (*task)();
+                lock.lock();
+
+                m_task = nullptr;
+                m_app_cv.notify_all();
+                continue;
+            }
+
+            if (!m_submitted.empty()) {
+                size_t index = m_submitted.front();
+                m_submitted.pop_front();
+                m_busy = true;
+
+                lock.unlock();
+                m_parent_ctx.renderer.m_replay(m_lists[index]);
+                m_parent_ctx.window.swap_buffers();
+
+                // asset handles held by the commands are released on this thread
+                m_lists[index].clear();
+                lock.lock();
+
+                m_busy = false;
+                m_free.push_back(index);
+                m_app_cv.notify_all();
+                continue;
+            }
+
+            break;
+        }
+
+        lock.unlock();
+
+        // the application thread is waiting in the destructor, so the list being recorded is safe to touch
+        m_parent_ctx.renderer.m_replay(m_lists[m_recording]);
+        m_lists[m_recording].clear();
+
+        m_parent_ctx.window.release_ctx();
+    }
+
+}
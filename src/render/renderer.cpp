@@ -1,25 +1,65 @@
 #include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <tuple>
 
 #include <render/renderer.h>
 #include <gfx/vertexarray.h>
 #include <gfx/shader.h>
+#include <gfx/instancebuffer.h>
+#include <gfx/texture/texture2d.h>
 #include <core/error_handler.h>
+#include <core/convert_values.h>
 #include <context/render_context.h>
 #include <core/logger.h>
 
 namespace bskgl {
 
+    // range of the index buffer (or vertices) a level of detail draws
+    static void lod_range(const VertexArray& vertexarray, uint32_t lod, size_t& first, size_t& count) {
+        const std::vector<LodLevel>& lods = vertexarray.lods();
+
+        if (lod < lods.size()) {
+            first = lods[lod].first_index;
+            count = lods[lod].num_indices;
+            return;
+        }
+
+        first = 0;
+        count = vertexarray.does_ibuffer_exist()? vertexarray.num_indices() : vertexarray.num_vertices();
+    }
+
     Renderer::Renderer(const RenderContext& parent_context)
         :
         m_parent_ctx(parent_context),
         m_cached_va(nullptr),
-        m_cached_shader(nullptr) { }
+        m_cached_shader(nullptr),
+        m_cached_pool(nullptr),
+        m_culling(false),
+        m_culled(0),
+        m_lod(false),
+        m_indirect(std::make_shared<IndirectBuffer>()) { }
 
     Renderer::Renderer(Renderer&& other) noexcept 
         :
         m_parent_ctx(other.m_parent_ctx),
         m_cached_va(other.m_cached_va),
-        m_cached_shader(other.m_cached_shader) { }
+        m_cached_shader(other.m_cached_shader),
+        m_cached_pool(other.m_cached_pool),
+        m_queue(std::move(other.m_queue)),
+        m_frustum(other.m_frustum),
+        m_culling(other.m_culling),
+        m_spheres(std::move(other.m_spheres)),
+        m_visible(std::move(other.m_visible)),
+        m_culled(other.m_culled),
+        m_lod_selector(other.m_lod_selector),
+        m_lod(other.m_lod),
+        m_lod_history(std::move(other.m_lod_history)),
+        m_lod_next(std::move(other.m_lod_next)),
+        m_lod_occurrences(std::move(other.m_lod_occurrences)),
+        m_indirect_draws(std::move(other.m_indirect_draws)),
+        m_indirect(std::move(other.m_indirect)) { }
 
     Renderer::~Renderer() {
 
@@ -29,6 +69,19 @@ namespace bskgl {
         if (!(m_cached_va) || va != m_cached_va->uuid()) {
             m_cached_va = m_parent_ctx.asset_manager.get_asset<VertexArray>(va);
         }
+
+        if (!(m_cached_va)) {
+            BSK_ERROR("Invalid asset UUID given.")
+            return;
+        }
+
+        this->render(va, shdr, m_cached_va->does_ibuffer_exist()? m_cached_va->num_indices() : m_cached_va->num_vertices());
+    }
+
+    void Renderer::render(UUID va, UUID shdr, size_t num_elements) {
+        if (!(m_cached_va) || va != m_cached_va->uuid()) {
+            m_cached_va = m_parent_ctx.asset_manager.get_asset<VertexArray>(va);
+        }
         if (!(m_cached_shader) || shdr != m_cached_shader->uuid()) {
             m_cached_shader = m_parent_ctx.asset_manager.get_asset<Shader>(shdr);
         }
@@ -38,20 +91,509 @@ namespace bskgl {
             return;
         }
 
+        if (m_parent_ctx.render_thread()) {
+            RenderCommand command;
+            command.type = RenderCommand::Type::Draw;
+            command.vertexarray = m_cached_va;
+            command.shader = m_cached_shader;
+            command.count = num_elements;
+            m_record(std::move(command));
+            return;
+        }
+
         m_parent_ctx.bind();
 
-        m_cached_shader->bind();
+        // programs still compiling skip their draws
+        if (!m_cached_shader->bind())
+            return;
+
         m_cached_va->bind();
 
-        if (m_cached_va->does_ibuffer_exist()) {
-            glDrawElements(GL_TRIANGLES, m_cached_va->num_indices(), GL_UNSIGNED_INT, nullptr);
-        } else {
-            glDrawArrays(GL_TRIANGLES, 0, m_cached_va->num_vertices());
+        Renderer::m_draw(*m_cached_va, num_elements);
+    }
+
+    void Renderer::render(UUID pool, UUID shdr, const MeshPool::Mesh& mesh) {
+        if (!(m_cached_pool) || pool != m_cached_pool->uuid()) {
+            m_cached_pool = m_parent_ctx.asset_manager.get_asset<MeshPool>(pool);
+        }
+        if (!(m_cached_shader) || shdr != m_cached_shader->uuid()) {
+            m_cached_shader = m_parent_ctx.asset_manager.get_asset<Shader>(shdr);
+        }
+
+        if (!(m_cached_pool) || !(m_cached_shader)) {
+            BSK_ERROR("Invalid asset UUID given.")
+            return;
+        }
+
+        if (m_parent_ctx.render_thread()) {
+            RenderCommand command;
+            command.type = RenderCommand::Type::DrawPooled;
+            command.pool = m_cached_pool;
+            command.shader = m_cached_shader;
+            command.mesh = mesh;
+            m_record(std::move(command));
+            return;
+        }
+
+        m_parent_ctx.bind();
+
+        if (!m_cached_shader->bind())
+            return;
+
+        m_cached_pool->bind();
+        m_cached_pool->draw(mesh);
+    }
+
+    void Renderer::render_instanced(UUID va, UUID shdr, UUID instance_buffer, size_t count) {
+        if (!(m_cached_va) || va != m_cached_va->uuid()) {
+            m_cached_va = m_parent_ctx.asset_manager.get_asset<VertexArray>(va);
+        }
+        if (!(m_cached_shader) || shdr != m_cached_shader->uuid()) {
+            m_cached_shader = m_parent_ctx.asset_manager.get_asset<Shader>(shdr);
+        }
+
+        auto instances = m_parent_ctx.asset_manager.get_asset<InstanceBuffer>(instance_buffer);
+
+        if (!(m_cached_va) || !(m_cached_shader) || !instances) {
+            BSK_ERROR("Invalid asset UUID given.")
+            return;
+        }
+
+        if (count > instances->num_instances()) {
+            BSK_WARNING("Instance count exceeds number of instances stored in the instance buffer.");
+            count = instances->num_instances();
+        }
+
+        if (m_parent_ctx.render_thread()) {
+            RenderCommand command;
+            command.type = RenderCommand::Type::DrawInstanced;
+            command.vertexarray = m_cached_va;
+            command.shader = m_cached_shader;
+            command.instances = instances;
+            command.count = count;
+            m_record(std::move(command));
+            return;
+        }
+
+        m_parent_ctx.bind();
+
+        if (m_cached_va->instance_buffer() != instance_buffer)
+            m_cached_va->attach_instance_buffer(instances);
+
+        if (!m_cached_shader->bind())
+            return;
+
+        m_cached_va->bind();
+
+        Renderer::m_draw(*m_cached_va, m_cached_va->does_ibuffer_exist()? m_cached_va->num_indices() : m_cached_va->num_vertices(), count);
+    }
+
+    void Renderer::submit(UUID va, UUID shdr, UUID texture, float depth) {
+        uint32_t lod = 0;
+
+        if (m_culling || m_lod) {
+            auto vertexarray = m_parent_ctx.asset_manager.get_asset<VertexArray>(va);
+            if (vertexarray) {
+                if (m_culling)
+                    m_spheres.push_back(vertexarray->bounds().center, vertexarray->bounds().radius);
+
+                lod = m_select_lod(*vertexarray, vertexarray->bounds(), 1.0f);
+            } else if (m_culling) {
+                m_spheres.push_back(glm::vec3(0.0f), INFINITY);
+            }
+        }
+
+        m_queue.submit(va, shdr, texture, depth, lod);
+    }
+
+    void Renderer::submit(UUID va, UUID shdr, const glm::mat4& model, UUID texture, float depth) {
+        uint32_t lod = 0;
+
+        if (m_culling || m_lod) {
+            auto vertexarray = m_parent_ctx.asset_manager.get_asset<VertexArray>(va);
+            if (vertexarray) {
+                Bounds bounds = vertexarray->bounds().transformed(model);
+
+                if (m_culling)
+                    m_spheres.push_back(bounds.center, bounds.radius);
+
+                // errors are in object space, the largest axis scale bounds how much the model stretches them
+                float scale = std::max({ glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2])) });
+                lod = m_select_lod(*vertexarray, bounds, scale);
+            } else if (m_culling) {
+                m_spheres.push_back(glm::vec3(0.0f), INFINITY);
+            }
+        }
+
+        m_queue.submit(va, shdr, texture, depth, lod);
+    }
+
+    void Renderer::submit(UUID pool, UUID shdr, const MeshPool::Mesh& mesh, const glm::mat4& model, UUID texture) {
+        if (!mesh.is_valid()) {
+            BSK_ERROR("Invalid mesh given.")
+            return;
+        }
+
+        m_indirect_draws.push_back({ pool, shdr, texture, mesh, model });
+    }
+
+    void Renderer::set_frustum(const Frustum& frustum) {
+        // draws queued before culling was enabled have no bounds, never cull them
+        if (!m_culling) {
+            m_spheres.clear();
+            for (size_t i = 0; i < m_queue.size(); i++)
+                m_spheres.push_back(glm::vec3(0.0f), INFINITY);
+        }
+
+        m_frustum = frustum;
+        m_culling = true;
+    }
+
+    void Renderer::disable_culling() {
+        m_culling = false;
+        m_spheres.clear();
+    }
+
+    void Renderer::set_lod(const LodSelector& selector) {
+        m_lod_selector = selector;
+        m_lod = true;
+    }
+
+    void Renderer::disable_lod() {
+        m_lod = false;
+        m_lod_history.clear();
+        m_lod_next.clear();
+        m_lod_occurrences.clear();
+    }
+
+    size_t Renderer::culled() const {
+        return m_culled;
+    }
+
+    void Renderer::flush() {
+        this->m_flush_indirect();
+
+        // levels selected since the last flush are the history of the next one, draws that weren't submitted drop out
+        m_lod_history.swap(m_lod_next);
+        m_lod_next.clear();
+        m_lod_occurrences.clear();
+
+        m_culled = 0;
+
+        if (m_culling) {
+            size_t submitted = m_queue.size();
+            if (m_frustum.cull(m_spheres, m_visible) != submitted)
+                m_queue.retain(m_visible);
+            m_culled = submitted - m_queue.size();
+            m_spheres.clear();
+        }
+
+        if (m_queue.empty())
+            return;
+
+        if (m_parent_ctx.render_thread()) {
+            // draws sharing a shader share one snapshot of its uniforms
+            std::shared_ptr<const Shader::Uniforms> uniforms;
+            UUID snapshot_shader = BSK_INVALID_UUID;
+
+            for (const RenderQueue::Command& command : m_queue.sort()) {
+                RenderCommand draw;
+                draw.type = RenderCommand::Type::Draw;
+                draw.shader = m_parent_ctx.asset_manager.get_asset<Shader>(command.shader);
+                draw.vertexarray = m_parent_ctx.asset_manager.get_asset<VertexArray>(command.vertexarray);
+                draw.texture = m_parent_ctx.asset_manager.get_asset<Texture2D>(command.texture);
+
+                if (!draw.shader || !draw.vertexarray) {
+                    BSK_ERROR("Invalid asset UUID given.")
+                    continue;
+                }
+
+                if (command.shader != snapshot_shader) {
+                    uniforms = std::make_shared<const Shader::Uniforms>(draw.shader->uniforms());
+                    snapshot_shader = command.shader;
+                }
+
+                draw.uniforms = uniforms;
+                lod_range(*draw.vertexarray, command.lod, draw.first, draw.count);
+                m_record(std::move(draw));
+            }
+
+            m_queue.clear();
+            return;
+        }
+
+        m_parent_ctx.bind();
+
+        UUID bound_shader = BSK_INVALID_UUID;
+        UUID bound_texture = BSK_INVALID_UUID;
+        UUID bound_va = BSK_INVALID_UUID;
+
+        for (const RenderQueue::Command& command : m_queue.sort()) {
+            if (command.shader != bound_shader) {
+                m_cached_shader = m_parent_ctx.asset_manager.get_asset<Shader>(command.shader);
+                if (!m_cached_shader) {
+                    BSK_ERROR("Invalid asset UUID given.")
+                    continue;
+                }
+
+                if (!m_cached_shader->bind())
+                    continue;
+
+                bound_shader = command.shader;
+            }
+
+            if (command.texture != bound_texture) {
+                auto texture = m_parent_ctx.asset_manager.get_asset<Texture2D>(command.texture);
+                if (texture)
+                    texture->bind();
+
+                bound_texture = command.texture;
+            }
+
+            if (command.vertexarray != bound_va) {
+                m_cached_va = m_parent_ctx.asset_manager.get_asset<VertexArray>(command.vertexarray);
+
+                // the cached vertex array is gone, the next command has to look its own up again
+                if (!m_cached_va) {
+                    BSK_ERROR("Invalid asset UUID given.")
+                    bound_va = BSK_INVALID_UUID;
+                    continue;
+                }
+
+                m_cached_va->bind();
+                bound_va = command.vertexarray;
+            }
+
+            size_t first = 0;
+            size_t count = 0;
+            lod_range(*m_cached_va, command.lod, first, count);
+
+            Renderer::m_draw(*m_cached_va, count, 0, first);
+        }
+
+        m_queue.clear();
+    }
+
+    void Renderer::m_flush_indirect() {
+        if (m_indirect_draws.empty())
+            return;
+
+        // a stable sort keeps the submission order within a bucket
+        std::stable_sort(m_indirect_draws.begin(), m_indirect_draws.end(), [](const IndirectDraw& a, const IndirectDraw& b) {
+            return std::tie(a.shader, a.texture, a.pool) < std::tie(b.shader, b.texture, b.pool);
+        });
+
+        struct Bucket {
+            IndirectBuffer::Range range;
+            AssetManager::AssetHandle<Shader> shader;
+            AssetManager::AssetHandle<Texture2D> texture;
+            AssetManager::AssetHandle<MeshPool> pool;
+        };
+
+        std::vector<DrawElementsIndirectCommand> commands;
+        std::vector<uint8_t> models;
+        std::vector<Bucket> buckets;
+
+        commands.reserve(m_indirect_draws.size());
+
+        for (size_t first = 0, last = 0; first < m_indirect_draws.size(); first = last) {
+            const IndirectDraw& head = m_indirect_draws[first];
+
+            for (last = first + 1; last < m_indirect_draws.size(); last++) {
+                const IndirectDraw& draw = m_indirect_draws[last];
+                if (draw.shader != head.shader || draw.texture != head.texture || draw.pool != head.pool)
+                    break;
+            }
+
+            Bucket bucket;
+            bucket.shader = m_parent_ctx.asset_manager.get_asset<Shader>(head.shader);
+            bucket.texture = m_parent_ctx.asset_manager.get_asset<Texture2D>(head.texture);
+            bucket.pool = m_parent_ctx.asset_manager.get_asset<MeshPool>(head.pool);
+
+            if (!bucket.shader || !bucket.pool) {
+                BSK_ERROR("Invalid asset UUID given.")
+                continue;
+            }
+
+            // gl_DrawID restarts at every multi draw, so the models of a bucket start at a bindable offset
+            size_t offset = (models.size() + IndirectBuffer::data_alignment - 1) / IndirectBuffer::data_alignment * IndirectBuffer::data_alignment;
+            models.resize(offset + (last - first) * sizeof(glm::mat4));
+
+            bucket.range.first_command = commands.size();
+            bucket.range.num_commands = last - first;
+            bucket.range.data_offset = offset;
+            bucket.range.data_size = (last - first) * sizeof(glm::mat4);
+
+            for (size_t index = first; index < last; index++) {
+                const IndirectDraw& draw = m_indirect_draws[index];
+
+                DrawElementsIndirectCommand command;
+                command.count = draw.mesh.num_indices;
+                command.first_index = draw.mesh.first_index;
+                command.base_vertex = static_cast<int32_t>(draw.mesh.base_vertex);
+                commands.push_back(command);
+
+                std::memcpy(models.data() + offset + (index - first) * sizeof(glm::mat4), &draw.model, sizeof(glm::mat4));
+            }
+
+            buckets.push_back(std::move(bucket));
         }
 
-        m_cached_shader->unbind();
-        m_cached_va->unbind();
+        m_indirect_draws.clear();
+
+        if (buckets.empty())
+            return;
+
+        if (m_parent_ctx.render_thread()) {
+            // the upload is recorded before the draws reading it
+            m_parent_ctx.execute([indirect = m_indirect, commands = std::move(commands), models = std::move(models)]() {
+                indirect->upload(commands, models);
+            });
+
+            for (Bucket& bucket : buckets) {
+                RenderCommand draw;
+                draw.type = RenderCommand::Type::DrawIndirect;
+                draw.shader = std::move(bucket.shader);
+                draw.texture = std::move(bucket.texture);
+                draw.pool = std::move(bucket.pool);
+                draw.indirect = bucket.range;
+                m_record(std::move(draw));
+            }
+
+            return;
+        }
+
+        m_parent_ctx.bind();
+        m_indirect->upload(commands, models);
+
+        for (const Bucket& bucket : buckets) {
+            if (!bucket.shader->bind())
+                continue;
+
+            if (bucket.texture)
+                bucket.texture->bind();
+
+            bucket.pool->bind();
+            m_indirect->draw(bucket.range, Renderer::draw_data_binding);
+        }
+    }
+
+    uint32_t Renderer::m_select_lod(const VertexArray& vertexarray, const Bounds& bounds, float scale) {
+        const std::vector<LodLevel>& lods = vertexarray.lods();
+
+        if (!m_lod || lods.empty())
+            return 0;
+
+        // the n-th draw of a vertex array continues the history of the n-th draw of the previous flush
+        uint64_t key = vertexarray.uuid() * 0x9E3779B97F4A7C15ull ^ m_lod_occurrences[vertexarray.uuid()]++;
+
+        auto previous = m_lod_history.find(key);
+        size_t level = m_lod_selector.select(lods, bounds.center, bounds.radius, scale, previous != m_lod_history.end() ? previous->second : LodSelector::none);
+
+        m_lod_next[key] = static_cast<uint32_t>(level);
+
+        return static_cast<uint32_t>(level);
+    }
+
+    void Renderer::m_record(RenderCommand&& command) const {
+        if (!command.uniforms)
+            command.uniforms = std::make_shared<const Shader::Uniforms>(command.shader->uniforms());
+
+        m_parent_ctx.render_thread()->record(std::move(command));
+    }
+
+    void Renderer::m_replay(const CommandList& commands) const {
+        m_parent_ctx.bind();
+
+        // uniforms of a program persist, only reapply them when the snapshot changes, programs still compiling skip their draws
+        const Shader* bound_shader = nullptr;
+        const Shader::Uniforms* bound_uniforms = nullptr;
+
+        for (const RenderCommand& command : commands) {
+            switch (command.type) {
+                case RenderCommand::Type::Task:
+                    command.task();
+
+                    bound_shader = nullptr;
+                    bound_uniforms = nullptr;
+                    break;
+
+                case RenderCommand::Type::Draw:
+                case RenderCommand::Type::DrawInstanced:
+                    if (command.type == RenderCommand::Type::DrawInstanced && command.vertexarray->instance_buffer() != command.instances->uuid())
+                        command.vertexarray->attach_instance_buffer(command.instances);
+
+                    if (command.shader.get() != bound_shader || command.uniforms.get() != bound_uniforms) {
+                        if (!command.shader->bind(*command.uniforms))
+                            break;
+
+                        bound_shader = command.shader.get();
+                        bound_uniforms = command.uniforms.get();
+                    }
+
+                    if (command.texture)
+                        command.texture->bind();
+
+                    command.vertexarray->bind();
+
+                    if (command.type == RenderCommand::Type::DrawInstanced) {
+                        const VertexArray& va = *command.vertexarray;
+                        Renderer::m_draw(va, va.does_ibuffer_exist()? va.num_indices() : va.num_vertices(), command.count);
+                    } else {
+                        Renderer::m_draw(*command.vertexarray, command.count, 0, command.first);
+                    }
+                    break;
+
+                case RenderCommand::Type::DrawPooled:
+                    if (command.shader.get() != bound_shader || command.uniforms.get() != bound_uniforms) {
+                        if (!command.shader->bind(*command.uniforms))
+                            break;
+
+                        bound_shader = command.shader.get();
+                        bound_uniforms = command.uniforms.get();
+                    }
+
+                    // meshes of the same pool share the vertex array, the state cache skips the rebind
+                    command.pool->bind();
+                    command.pool->draw(command.mesh);
+                    break;
+
+                case RenderCommand::Type::DrawIndirect:
+                    if (command.shader.get() != bound_shader || command.uniforms.get() != bound_uniforms) {
+                        if (!command.shader->bind(*command.uniforms))
+                            break;
+
+                        bound_shader = command.shader.get();
+                        bound_uniforms = command.uniforms.get();
+                    }
+
+                    if (command.texture)
+                        command.texture->bind();
+
+                    command.pool->bind();
+                    m_indirect->draw(command.indirect, Renderer::draw_data_binding);
+                    break;
+            }
+        }
     }
 
+    void Renderer::m_draw(const VertexArray& vertexarray, size_t num_elements, size_t instances, size_t first) {
+        if (vertexarray.does_ibuffer_exist()) {
+            GLenum type = opengl::convert(vertexarray.index_type());
+
+            size_t index_size = vertexarray.index_type() == IndexType::UnsignedShort ? sizeof(uint16_t) : sizeof(uint32_t);
+            const void* offset = reinterpret_cast<const void*>(first * index_size);
+
+            if (instances)
+                glDrawElementsInstanced(GL_TRIANGLES, num_elements, type, offset, instances);
+            else
+                glDrawElements(GL_TRIANGLES, num_elements, type, offset);
+        } else {
+            if (instances)
+                glDrawArraysInstanced(GL_TRIANGLES, first, num_elements, instances);
+            else
+                glDrawArrays(GL_TRIANGLES, first, num_elements);
+        }
+    }
 
 }
\ No newline at end of file
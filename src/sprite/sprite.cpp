@@ -4,24 +4,44 @@
 
 namespace bskgl {
 
+    // pixels loaded by stb_image are freed by it
+    static void free_loaded(uint8_t* data) {
+        stbi_image_free(data);
+    }
+
+    static void free_allocated(uint8_t* data) {
+        delete[] data;
+    }
+
     Sprite::Sprite() 
         :
         m_width(0),
         m_height(0),
         m_channels(0),
-        m_data(nullptr) { }
+        m_data(nullptr, free_allocated) { }
 
-    Sprite::Sprite(const std::filesystem::path& path) {
+    Sprite::Sprite(const std::filesystem::path& path)
+        :
+        m_data(nullptr, free_loaded) {
         this->read_from(path);
     }
 
-    Sprite::Sprite(const Sprite& other) {
+    Sprite::Sprite(int32_t width, int32_t height, int32_t channels)
+        :
+        m_width(width),
+        m_height(height),
+        m_channels(channels),
+        m_data(new uint8_t[width * height * channels](), free_allocated) { }
+
+    Sprite::Sprite(const Sprite& other)
+        :
+        m_data(nullptr, free_allocated) {
         m_width = other.m_width;
         m_height = other.m_height;
         m_channels = other.m_channels;
         
         if (other.m_data) {
-            m_data = std::make_unique<uint8_t[]>(m_width * m_height * m_channels);
+            m_data = PixelData(new uint8_t[m_width * m_height * m_channels], free_allocated);
             std::copy(other.m_data.get(), other.m_data.get() + (m_width * m_height * m_channels), m_data.get());
         } else {
             m_data = nullptr;
@@ -37,7 +57,7 @@ namespace bskgl {
         m_channels = other.m_channels;
     
         if (other.m_data) {
-            m_data = std::make_unique<uint8_t[]>(m_width * m_height * m_channels);
+            m_data = PixelData(new uint8_t[m_width * m_height * m_channels], free_allocated);
             std::copy(other.m_data.get(), other.m_data.get() + (m_width * m_height * m_channels), m_data.get());
         } else {
             m_data = nullptr;
@@ -46,11 +66,7 @@ namespace bskgl {
         return *this;
     }
 
-    Sprite::~Sprite() {
-        if (m_data) {
-            stbi_image_free(m_data.release());
-        }
-    }
+    Sprite::~Sprite() = default;
 
     int32_t Sprite::width() const {
         return m_width;
@@ -68,14 +84,16 @@ namespace bskgl {
         return m_data.get();
     }
 
+    unsigned char* Sprite::data() {
+        return m_data.get();
+    }
+
     Sprite& Sprite::read_from(const std::filesystem::path& path) {
-        if (m_data) {
-            stbi_image_free(m_data.release());
-        }
+        m_data.reset();
 
-        const char* filepath = path.string().c_str();
+        std::string filepath = path.string();
 
-        m_data.reset(stbi_load(filepath, &m_width, &m_height, &m_channels, 0));
+        m_data = PixelData(stbi_load(filepath.c_str(), &m_width, &m_height, &m_channels, 0), free_loaded);
         
         if (!m_data) {
             throw std::runtime_error("Couldn't load file " + path.string());
@@ -88,4 +106,10 @@ namespace bskgl {
         return m_data != nullptr;
     }
 
+    Sprite& Sprite::release() {
+        m_data.reset();
+
+        return *this;
+    }
+
 }
\ No newline at end of file
@@ -174,6 +174,15 @@ namespace bskgl {
         glfwMakeContextCurrent(m_window);
     }
 
+    void Window::release_ctx() const {
+        if (this->is_current_ctx())
+            glfwMakeContextCurrent(nullptr);
+    }
+
+    bool Window::is_current_ctx() const {
+        return glfwGetCurrentContext() == m_window;
+    }
+
     bool Window::is_open() const {
         return !glfwWindowShouldClose(m_window);
     }